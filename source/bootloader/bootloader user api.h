@@ -1,9 +1,9 @@
-/********************************************************
-application calls for Bootloader.
-
-Author: LTR
-File: bootloader user api.h
-********************************************************/
-
-void boot_init(void);
+/********************************************************
+application calls for Bootloader.
+
+Author: LTR
+File: bootloader user api.h
+********************************************************/
+
+void boot_init(void);
 void boot_call(void);
\ No newline at end of file
@@ -1,38 +1,64 @@
-// Common definitions that aren't defined in pub_type.h
-//
-// Don't want to modify pub_def.h since it's part of SMAC
-#ifndef ___COMMON_DEF_H
-#define ___COMMON_DEF_H 
-
-
-typedef unsigned char BOOL;
-
-typedef signed char INT8;
-typedef unsigned char UINT8;
-typedef volatile signed char VINT8;
-typedef volatile unsigned char VUINT8;
-
-typedef signed short INT16;
-typedef unsigned short UINT16;
-typedef volatile signed short VINT16;
-typedef volatile unsigned short VUINT16;
-
-typedef signed long INT32;
-typedef unsigned long UINT32;
-typedef volatile signed long VINT32;
-typedef volatile unsigned long VUINT32;
-
-
-#define getMax(a,b)    (((a) > (b)) ? (a) : (b))
-#define getMin(a,b)    (((a) < (b)) ? (a) : (b))
-
-// currently only converts positive numbers up to hundreds
-void itoa(unsigned int num, char *buf, int buflen);
-
-// take the square root of an integer
-//unsigned long iSqrt(unsigned long value);
-long isqrt (long x);
-
-
-
-#endif
+// Common definitions that aren't defined in pub_type.h
+//
+// Don't want to modify pub_def.h since it's part of SMAC
+#ifndef ___COMMON_DEF_H
+#define ___COMMON_DEF_H 
+
+
+typedef unsigned char BOOL;
+
+typedef signed char INT8;
+typedef unsigned char UINT8;
+typedef volatile signed char VINT8;
+typedef volatile unsigned char VUINT8;
+
+typedef signed short INT16;
+typedef unsigned short UINT16;
+typedef volatile signed short VINT16;
+typedef volatile unsigned short VUINT16;
+
+typedef signed long INT32;
+typedef unsigned long UINT32;
+typedef volatile signed long VINT32;
+typedef volatile unsigned long VUINT32;
+
+
+// Critical sections that put the interrupt mask back the way they found
+// it, so they work from main code and from inside an interrupt handler.
+// ccr is a static UINT8 the caller owns, the asm can't reach locals.
+// It is only stored once masked, so an interrupt can't overwrite it,
+// but sections using the same one must not nest.
+#ifndef HOST_SIM
+#define CRITICAL_ENTER(ccr)  { asm TPA; asm SEI; asm STA ccr; }
+#define CRITICAL_EXIT(ccr)   { asm LDA ccr; asm TAP; }
+#else
+// The host simulation only delivers interrupts from the stand-ins
+#define CRITICAL_ENTER(ccr)  ((void)(ccr))
+#define CRITICAL_EXIT(ccr)   ((void)(ccr))
+#endif
+
+#define getMax(a,b)    (((a) > (b)) ? (a) : (b))
+#define getMin(a,b)    (((a) < (b)) ? (a) : (b))
+
+// currently only converts positive numbers up to hundreds
+void itoa(unsigned int num, char *buf, int buflen);
+
+// take the square root of an integer
+//unsigned long iSqrt(unsigned long value);
+long isqrt (long x);
+
+// Methods for vectorMagnitude(), pick one with MAGNITUDE_METHOD
+#define MAGNITUDE_ISQRT32     0  // isqrt() on 32 bit sum of squares
+#define MAGNITUDE_ISQRT16     1  // same result as isqrt, 16 bit math only
+#define MAGNITUDE_ALPHA_BETA  2  // no square root at all, within ~10%
+
+#ifndef MAGNITUDE_METHOD
+#define MAGNITUDE_METHOD      MAGNITUDE_ISQRT16
+#endif
+
+// length of an (x,y,z) vector of 8 bit readings: sqrt(x^2+y^2+z^2)
+UINT16 vectorMagnitude(UINT8 x, UINT8 y, UINT8 z);
+
+
+
+#endif
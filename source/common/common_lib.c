@@ -1,81 +1,169 @@
-/****************************************************************************
-* common_lib.c
-* 
-* Author: Bill Bishop - Sixth Sensor
-* Title: 	common_lib.c
-* 
-* Commonly used utilities.
-*
-****************************************************************************/
-#include "common_def.h"
-
-/****************************************************************************
-* itoa
-*
-* Description: converts ints to ascii.  Currently on positive numbers.
-*
-* Parms:       num - integer to convert
-*              buf - pointer to converted ascii string
-*              buflen - length of buf
-*
-* Returns:     nothing
-***************************************************************************/
-void itoa(unsigned int num, char *buf, int buflen) {
-
-  int tmp, idx, units, n;
-  for (units = 100, idx=0,tmp=num; units > 0 && idx < buflen;) {
-    n = tmp / units;
-    buf[idx++] = n + '0';
-    if (tmp >= units)
-      tmp = tmp - (n * units);
-    units/=10;
-  }
-
-  buf[idx] = '\0';
-}
-
-
-/****************************************************************************
-* isqrt
-*
-* Description: Integer square root by Halleck's method, with Legalize's speedup
-*
-* Parms:       x - take square root of this
-*
-* Returns:     square root of x
-***************************************************************************/
-long isqrt (long x)
-{
-
-  static long   squaredbit, remainder, root, lTmp;
-
-  /* Load the binary constant 01 00 00 ... 00, where the number
-   * of zero bits to the right of the single one bit
-   * is even, and the one bit is as far left as is consistant
-   * with that condition.)
-   */
-  squaredbit  = (long) ((((unsigned long) ~0L) >> 1) & 
-                        ~(((unsigned long) ~0L) >> 2));
-  /* This portable load replaces the loop that used to be 
-   * here, and was donated by  legalize@xmission.com 
-   */
-
-  /* Form bits of the answer. */
-  remainder = x;  
-  root = 0L;
-  while (squaredbit > 0L) {
-    lTmp = squaredbit | root;
-    if (remainder >= lTmp) {
-      remainder -= lTmp;
-      root >>= 1; 
-      root |= squaredbit;
-    } else {
-      root >>= 1;
-    }
-    squaredbit >>= 2; 
-  }
-
-  return root;
-}
-
-
+/****************************************************************************
+* common_lib.c
+* 
+* Author: Bill Bishop - Sixth Sensor
+* Title: 	common_lib.c
+* 
+* Commonly used utilities.
+*
+****************************************************************************/
+#include "common_def.h"
+
+/****************************************************************************
+* itoa
+*
+* Description: converts ints to ascii.  Currently on positive numbers.
+*              No leading zeros.
+*
+* Parms:       num - integer to convert
+*              buf - pointer to converted ascii string
+*              buflen - length of buf, including the terminator
+*
+* Returns:     nothing
+***************************************************************************/
+void itoa(unsigned int num, char *buf, int buflen) {
+
+  unsigned int units;
+  int idx=0;
+
+  // find the first digit, a 16 bit int has at most 5
+  for (units = 10000; units > 1 && units > num; units /= 10) {
+  }
+
+  for (; units > 0 && idx < buflen-1; units /= 10) {
+    buf[idx++] = (char)(num / units) + '0';
+    num %= units;
+  }
+
+  buf[idx] = '\0';
+}
+
+
+/****************************************************************************
+* isqrt
+*
+* Description: Integer square root by Halleck's method, with Legalize's speedup
+*
+* Parms:       x - take square root of this
+*
+* Returns:     square root of x
+***************************************************************************/
+long isqrt (long x)
+{
+
+  static long   squaredbit, remainder, root, lTmp;
+
+  /* Load the binary constant 01 00 00 ... 00, where the number
+   * of zero bits to the right of the single one bit
+   * is even, and the one bit is as far left as is consistant
+   * with that condition.)
+   */
+  squaredbit  = (long) ((((unsigned long) ~0L) >> 1) & 
+                        ~(((unsigned long) ~0L) >> 2));
+  /* This portable load replaces the loop that used to be 
+   * here, and was donated by  legalize@xmission.com 
+   */
+
+  /* Form bits of the answer. */
+  remainder = x;  
+  root = 0L;
+  while (squaredbit > 0L) {
+    lTmp = squaredbit | root;
+    if (remainder >= lTmp) {
+      remainder -= lTmp;
+      root >>= 1; 
+      root |= squaredbit;
+    } else {
+      root >>= 1;
+    }
+    squaredbit >>= 2; 
+  }
+
+  return root;
+}
+
+
+/****************************************************************************
+* vectorMagnitude
+*
+* Description: Length of a vector made of three 8 bit readings,
+*              sqrt(x^2 + y^2 + z^2).  This gets called for every
+*              accelerometer sample so MAGNITUDE_METHOD picks how:
+*
+*              MAGNITUDE_ISQRT32 - sum of squares in a long, isqrt()
+*              MAGNITUDE_ISQRT16 - exact, but the largest possible sum
+*                of squares is only 18 bits and the root only 9 bits,
+*                so the digit by digit square root can be done in 9 
+*                passes of 16 bit math instead of 16 passes of 32 bit.
+*              MAGNITUDE_ALPHA_BETA - max + 11/32 mid + 1/4 min.  Error
+*                is within about 10% so the jolt and movement thresholds
+*                would need re-tuning.
+*
+* Parms:       x, y, z - axis readings
+*
+* Returns:     magnitude of the vector (0-441)
+***************************************************************************/
+UINT16 vectorMagnitude(UINT8 x, UINT8 y, UINT8 z)
+{
+#if MAGNITUDE_METHOD == MAGNITUDE_ISQRT16
+  UINT16 sumLo, square, root, remainder, trial;
+  UINT8  sumHi, i;
+
+  // Sum of the squares, bits 16-17 go in sumHi
+  sumLo  = (UINT16)x * x;
+  square = (UINT16)y * y;
+  sumLo += square;
+  sumHi  = (sumLo < square);
+  square = (UINT16)z * z;
+  sumLo += square;
+  sumHi += (sumLo < square);
+
+  // Form the bits of the answer 2 bits of the sum at a time, top 
+  // bits first.  The remainder never gets bigger than 2*root so it 
+  // easily fits in 16 bits.
+  remainder = sumHi;
+  root = 0;
+  if (remainder >= 1) {
+    remainder -= 1;
+    root = 1;
+  }
+
+  for (i=0; i<8; i++) {
+    remainder = (remainder << 2) | (sumLo >> 14);
+    sumLo <<= 2;
+    trial = (root << 2) | 1;
+    root <<= 1;
+    if (remainder >= trial) {
+      remainder -= trial;
+      root |= 1;
+    }
+  }
+
+  return root;
+
+#elif MAGNITUDE_METHOD == MAGNITUDE_ALPHA_BETA
+  UINT8 tmp;
+
+  // sort so that x >= y >= z
+  if (x < y) {
+    tmp = x; x = y; y = tmp;
+  }
+  if (y < z) {
+    tmp = y; y = z; z = tmp;
+  }
+  if (x < y) {
+    tmp = x; x = y; y = tmp;
+  }
+
+  return x + ((11 * (UINT16)y + 8 * (UINT16)z) >> 5);
+
+#else
+  static long sumOfSquares;
+
+  sumOfSquares  = (long)x * x;
+  sumOfSquares += (long)y * y;
+  sumOfSquares += (long)z * z;
+
+  return (UINT16)isqrt(sumOfSquares);
+#endif
+}
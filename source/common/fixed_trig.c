@@ -0,0 +1,111 @@
+/****************************************************************************
+* fixed_trig.c
+*
+* Author: Bill Bishop - Sixth Sensor
+* Title: 	fixed_trig.c
+*
+* Fixed point trig functions.  The HCS08 has no FPU and a 32 bit divide
+* is expensive, so everything here is done with 16 bit adds and shifts.
+*
+****************************************************************************/
+#include "fixed_trig.h"
+
+// Internal angle units are 1/16th of a tenth of a degree (1/160 degree)
+// so that rounding errors don't pile up over the CORDIC iterations.
+#define CORDIC_ANGLE_SHIFT    4
+#define CORDIC_ANGLE_ROUND    (1 << (CORDIC_ANGLE_SHIFT - 1))
+
+// Inputs are scaled so the larger axis lands in this range.  Keeps
+// as many bits of precision as possible without overflowing a 16 bit
+// int after the CORDIC gain (~1.16) is applied.
+#define CORDIC_NORMALIZE_MIN  0x2000
+#define CORDIC_NORMALIZE_MAX  0x4000
+
+// atan(2^-i) in 1/160 degree, starting at i=1.  The octant reduction
+// already puts the angle between 0 and 45 degrees so i=0 isn't needed.
+static const INT16 cordicAtanTable[FIXED_ATAN2_ITERATIONS] =
+{ 4250, 2246, 1140, 572, 286, 143, 72, 36, 18, 9, 4, 2 };
+
+/****************************************************************************
+* fixedAtan2
+*
+* Description: Arctangent of y/x using CORDIC vectoring.  Reduces the vector
+*              to the first octant (0-45 degrees), rotates it onto the x
+*              axis summing up the rotation angles, then unfolds the result
+*              back into the proper quadrant.  No divides or multiplies.
+*
+* Parms:       y - y component (any sign)
+*              x - x component (any sign)
+*
+* Returns:     angle in tenths of a degree 0-3599, or FIXED_ATAN2_INVALID
+*              if both components are 0
+***************************************************************************/
+INT16 fixedAtan2(INT16 y, INT16 x)
+{
+  UINT16 absX, absY, swap;
+  INT16  cordicX, cordicY, tmp;
+  INT16  angle;
+  UINT8  i;
+  BOOL   swapped;
+
+  if (x == 0 && y == 0) {
+    return FIXED_ATAN2_INVALID;
+  }
+
+  absX = (x < 0) ? (UINT16)(0 - (UINT16)x) : (UINT16)x;
+  absY = (y < 0) ? (UINT16)(0 - (UINT16)y) : (UINT16)y;
+
+  // Reduce to first octant, y <= x
+  swapped = (absY > absX);
+  if (swapped) {
+    swap = absX;
+    absX = absY;
+    absY = swap;
+  }
+
+  // Normalize so the small accelerometer readings get full precision
+  while (absX >= CORDIC_NORMALIZE_MAX) {
+    absX >>= 1;
+    absY >>= 1;
+  }
+  while (absX < CORDIC_NORMALIZE_MIN) {
+    absX <<= 1;
+    absY <<= 1;
+  }
+
+  // Rotate the vector onto the x axis
+  cordicX = (INT16)absX;
+  cordicY = (INT16)absY;
+  angle   = 0;
+  for (i=0; i<FIXED_ATAN2_ITERATIONS; i++) {
+    tmp = cordicX;
+    if (cordicY > 0) {
+      cordicX += cordicY >> (i+1);
+      cordicY -= tmp >> (i+1);
+      angle   += cordicAtanTable[i];
+    } else {
+      cordicX -= cordicY >> (i+1);
+      cordicY += tmp >> (i+1);
+      angle   -= cordicAtanTable[i];
+    }
+  }
+
+  // back to tenths of a degree
+  if (angle < 0) {
+    angle = 0;
+  }
+  angle = (angle + CORDIC_ANGLE_ROUND) >> CORDIC_ANGLE_SHIFT;
+
+  // Unfold octant, then quadrant
+  if (swapped) {
+    angle = FIXED_ANGLE_90_DEG - angle;
+  }
+  if (x < 0) {
+    angle = FIXED_ANGLE_180_DEG - angle;
+  }
+  if (y < 0 && angle > 0) {
+    angle = FIXED_ANGLE_360_DEG - angle;
+  }
+
+  return angle;
+}
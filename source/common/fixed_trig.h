@@ -0,0 +1,23 @@
+#ifndef __FIXED_TRIG_H
+#define __FIXED_TRIG_H
+
+#include "common_def.h"
+
+// Fixed point trig.  Angles are returned in tenths of a degree,
+// counter clockwise from the positive x axis, 0-3599.
+#define FIXED_ANGLE_PRECISION   10
+#define FIXED_ANGLE_90_DEG      900
+#define FIXED_ANGLE_180_DEG     1800
+#define FIXED_ANGLE_360_DEG     3600
+
+// Returned by fixedAtan2() when both parameters are 0 (no angle)
+#define FIXED_ATAN2_INVALID     (-1)
+
+// Number of CORDIC rotations.  Each rotation adds about one bit
+// of precision, 12 gets the error under a tenth of a degree.
+#define FIXED_ATAN2_ITERATIONS  12
+
+// arctangent of y/x in all four quadrants without a divide
+INT16 fixedAtan2(INT16 y, INT16 x);
+
+#endif
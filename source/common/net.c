@@ -1,234 +1,1241 @@
-/****************************************************************************
-* net.c
-* 
-* Author: Bill Bishop - Sixth Sensor
-* Title: 	net.c
-* 
-* This file contains procedures to abstract the layer3 signalling for the
-* remote wah pedal system.
-*
-****************************************************************************/
-
-#include "simple_mac.h"
-#include "MC13192_hw_config.h"
-#include "SCI.h"
-#include "drivers.h"
-#include "sard_board.h"
-#include "HAL.h"
-#include "net.h"
-
-// Possible channels to communicate on
-static t_powerScan scanChannels[]={ {0,POWER_SETTING},{5,POWER_SETTING},
-  {10,POWER_SETTING},{15,POWER_SETTING}};
-static UINT8 numScanChannels=sizeof(scanChannels)/sizeof(scanChannels[0]);
-
-// Index into scanChannels, determines current channel
-static UINT8 scanChannelIndex=0;
-static t_NetTransNum transNum=0;
-
-
-// Header, not to be confused with other SMAC devices
-static t_NetPacket netPacket={NET_ID_STRING, 0, 0};
-
-static t_NetCallback appCallback=NULL;
-
-// Data structures for communicating with Simple MAC layer
-static rx_packet_t rxPacket;
-static tx_packet_t txPacket;
-static byte rxDataBuffer[MAX_PACKET_BUFFER];
-
-// Prototypes
-t_NetTransNum getNexTransNum(void);
-
-/****************************************************************************
- * stopReceive
- *
- * Description: Cancels outstanding receives,
- *
- * Parms:       none
- *
- * Returns:     0 if success, 1 if error
- ***************************************************************************/
-int stopReceive(void)
-{
-  int retcode = 0;
-
-  // bring 13192 into idle mode
-  if (MLME_RX_disable_request() == ERROR) {
-    retcode = 1;  
-  }
-
-  return retcode;
-}
-
-/****************************************************************************
- * rcvRFData
- *
- * Description: Application calls this to be notified when packets arrive.
- *              The callback function is used to notify the application when 
- *              a packet is received.  This net layer only supports one 
- *              outstanding transaction at a time.  
- *
- * Parms:       pCallback - function pointer to be called when packet received.
- *
- * Returns:     0 if success, 1 if error
- ***************************************************************************/
-int rcvRFData(t_NetCallback pCallback)
-{
-  if (pCallback != NULL) {
-    appCallback = pCallback;
-  }
-
-  // Setup the receive packet
-  rxPacket.dataLength = 0;
-  rxPacket.data = &rxDataBuffer[0];
-  rxPacket.maxDataLength = sizeof(t_NetPacket);
-  rxPacket.status = 0;
-
-  // return immediately, no delay 
-  MLME_RX_enable_request(&rxPacket, NO_ACK_DELAY);          
-}
-
-/****************************************************************************
- * MCPS_data_indication
- *
- * Description: SMAC (layer-2) will call this when packet arrives. This proc
- *              will then check the contents of the packet.  Only if valid
- *              packet will application be called.
- *
- * Parms:       rx_packet - pointer to received packet.
- *
- * Returns:     nothing
- ***************************************************************************/
-void MCPS_data_indication(rx_packet_t *rx_packet) 
-{
-  t_NetPacket *pPacket;
-
-  // Get pointer to data  
-  pPacket = (t_NetPacket *)rx_packet->data; 
-
-  if (rx_packet->status == SUCCESS) {
-    // Packet received, see if id string matches
-#ifndef MVMT_DEBUG
-    if (memcmp(NET_ID_STRING, pPacket->idString, NET_IDSTRING_STRLEN) == 0)
-#endif // all packets valid if debugging
-    {
-      // valid packet
-      if (appCallback != NULL) {
-        appCallback(pPacket);
-      }
-
-    }// if good ack
-  }
-}
-
-/****************************************************************************
- * MLME_MC13192_reset_indication
- *
- * Description: resets 13192
- *
- * Parms:       nothing
- *
- * Returns:     nothing
- ***************************************************************************/
-void MLME_MC13192_reset_indication() 
-{
-  // Notifies you that the MC13192 has been reset.
-  // Application must handle this here.
-  //
-  // do nothing.
-}
-
-
-/****************************************************************************
- * selectNextRFChannel
- *
- * Description: Selects next RF Channel
- *
- * Parms:       nothing
- *
- * Returns:     nothing
- ***************************************************************************/
-void selectNextRFChannel()
-{
-  if (++scanChannelIndex >= numScanChannels)
-    scanChannelIndex=0;
-
-  setRFChannel();
-}
-
-/****************************************************************************
- * setRFChannel
- *
- * Description: sets next RF Channel
- *
- * Parms:       nothing
- *
- * Returns:     nothing
- ***************************************************************************/
-void setRFChannel()
-{
-
-  // Set tx channel  
-  MLME_set_channel_request(scanChannels[scanChannelIndex].channel);
-
-  // Set MAX power setting
-  MLME_MC13192_PA_output_adjust(scanChannels[scanChannelIndex].power);
-}
-
-/****************************************************************************
- * setRFChannel
- *
- * Description: Sends a complete packet to receiver.  SMAC will do a
- *              low power while during the transmission
- *
- * Parms:       packet - pointer to outgoing layer 3 packet
- *
- * Returns:     1 if success, 0 if fail
- ***************************************************************************/
-int sendRFPacket(t_NetPacket *packet)
-{
-  int retcode = TRUE;
-
-  // Setup packet to be passed to SMAC
-  txPacket.data = packet; 
-  txPacket.dataLength = sizeof(t_NetPacket);
-
-  // Send the packet
-  if (MCPS_data_request(&txPacket) != SUCCESS) {
-    // problem occured
-    retcode = FALSE;
-  }
-
-  return retcode;
-}
-
-/****************************************************************************
- * sendRFMessage
- *
- * Description: Sends a status message to receiver.  Returns immediately and 
- *             leaves the RF receiver on, waiting for packet.  It is the 
- *             responsibility of the application to monitor received packets
- *             and to handle timing out.  The application MUST NOT go into 
- *             sleep mode until a packet is received (or timeout).  Otherwise 
- *             the return packet may be lost.
- *
- * Parms:       msgType - layer 3 message type
- *
- * Returns:     1 if success, 0 if fail
- ***************************************************************************/
-int sendRFMessage(t_NetMsgType msgType)
-{
-  int retcode = TRUE;
-
-  // Setup the data packet
-  // NOTE: header.idString is already setup for speed
-  netPacket.msgType = msgType;
-
-  // Initialize data section
-  //memset(netPacket.data, 0, sizeof(netPacket.data));
-
-  retcode = sendRFPacket(&netPacket);  
-  return retcode;
-}
-
+/****************************************************************************
+* net.c
+* 
+* Author: Bill Bishop - Sixth Sensor
+* Title: 	net.c
+* 
+* This file contains procedures to abstract the layer3 signalling for the
+* remote wah pedal system.
+*
+****************************************************************************/
+
+#include <hidef.h> /* for EnableInterrupts macro */
+#include "simple_mac.h"
+#include "MC13192_hw_config.h"
+#include "SCI.h"
+#include "drivers.h"
+#include "mcu_hw_config.h"
+#include "sard_board.h"
+#include "HAL.h"
+#include "net.h"
+
+// Channel and power in use.  Both ends start on the default
+// channel, the transmitter moves them with selectQuietRFChannel.
+static UINT8 rfChannel=NET_DEFAULT_CHANNEL;
+static UINT8 rfPower=POWER_SETTING;
+static t_NetTransNum transNum=0;
+
+// Channels the site survey picks from
+#ifdef NET_SURVEY_ALL_CHANNELS
+#define NUM_SURVEY_CHANNELS   PHY_NUM_CHANNELS
+#define surveyChannel(i)      (i)
+#else
+static const UINT8 surveyChannels[]={0, 5, 10, 15};
+#define NUM_SURVEY_CHANNELS   (sizeof(surveyChannels)/sizeof(surveyChannels[0]))
+#define surveyChannel(i)      surveyChannels[i]
+#endif
+
+// Energy detect result for each channel from the last survey, 
+// the quietest reading is the biggest (see MLME_energy_detect).
+// Channels not surveyed stay 0, the loudest.
+static UINT8 channelEnergy[PHY_NUM_CHANNELS];
+
+// Least time left worth turning the receiver on for, 13192 ticks
+#define ACK_GUARD_TICKS       64
+
+
+// Header, not to be confused with other SMAC devices
+static t_NetPacket netPacket={NET_ID_STRING, 0, 0};
+
+static t_NetCallback appCallback=NULL;
+
+// Data structures for communicating with Simple MAC layer.
+// There are two receive buffers so that in continuous receive 
+// the radio can be re-armed into one while the application is
+// still looking at the packet in the other.
+static rx_packet_t rxPacket[NET_RX_BUFFERS];
+static tx_packet_t txPacket;
+static byte rxDataBuffer[NET_RX_BUFFERS][MAX_PACKET_BUFFER];
+static UINT8 rxBufferIdx=0;           // buffer the radio fills next
+static volatile BOOL rxContinuous=FALSE;
+static volatile BOOL rxArmed=FALSE;
+static volatile BOOL txBusy=FALSE;    // asynchronous send in the air
+static volatile BOOL rxDone;          // receive finished, any status
+static volatile BOOL ackSeen;         // WAH_ACK arrived
+
+// Motion frame statistics (receiving side)
+static UINT16 netStats[MAX_NET_STATS];
+static BOOL   statsSynced=FALSE;      // FALSE until first frame seen
+static t_NetTransNum nextTransNum=0;  // expected next frame
+static t_time lastTransit=0;          // receive - send time, last frame
+static UINT32 jitterSum=0;            // jitter, 4 fraction bits
+static UINT8  statsCcr;               // CCR while a statistic is read
+
+// Jitter smoothing, 1/16 of each change like RFC 3550
+#define NET_JITTER_SHIFT  4
+
+// Link report (both sides), see t_NetLinkReport.  The local one
+// is built up as frames arrive and starts over each time it is
+// sent, the peer's is the last one received.
+static UINT8  linkLqiMin;
+static UINT8  linkLqiMax;
+static UINT16 linkLqiSum;
+static UINT8  linkSamples;
+static UINT8  linkLost;
+static UINT16 linkMvmtLostBase;       // NET_STAT_LOST at last report
+static t_NetTransNum linkTxSeq=0;     // last keepalive sent
+static t_NetTransNum linkRxSeq=0;     // last keepalive received
+static BOOL   linkRxSynced=FALSE;
+static BOOL   linkAckPending=FALSE;   // keepalive sent, no ack yet
+static t_NetLinkReport linkPeer;
+static volatile BOOL linkPeerFresh=FALSE;
+static UINT8  linkCcr;                // CCR while the link counts are read
+static UINT8  powerGoodReports=0;     // in a row, toward a step down
+
+// Prototypes
+t_NetTransNum getNexTransNum(void);
+static int sendMotionPacket(t_NetPacket *packet);
+static void updateRFStats(t_NetPacket *packet);
+static void statAdd(UINT8 statId, UINT16 count);
+static void linkSample(UINT8 lqi);
+static void linkReceived(t_NetPacket *packet);
+static void setLinkReport(t_NetPacket *packet);
+static void linkLocal(t_NetLinkReport *report);
+static void armReceive(UINT32 timeout);
+static BOOL waitRFAck(void);
+static BOOL findReceiver(void);
+static void surveyRFChannels(void);
+static BOOL moveRFChannel(UINT8 channel);
+
+/****************************************************************************
+ * stopReceive
+ *
+ * Description: Cancels outstanding receives,
+ *
+ * Parms:       none
+ *
+ * Returns:     0 if success, 1 if error
+ ***************************************************************************/
+int stopReceive(void)
+{
+  int retcode = 0;
+
+  rxContinuous = FALSE;
+  rxArmed = FALSE;
+
+  // bring 13192 into idle mode
+  if (MLME_RX_disable_request() == ERROR) {
+    retcode = 1;  
+  }
+
+  return retcode;
+}
+
+/****************************************************************************
+ * rcvRFData
+ *
+ * Description: Application calls this to be notified when packets arrive.
+ *              The callback function is used to notify the application when 
+ *              a packet is received.  This net layer only supports one 
+ *              outstanding transaction at a time.  
+ *
+ * Parms:       pCallback - function pointer to be called when packet received.
+ *
+ * Returns:     0 if success, 1 if error
+ ***************************************************************************/
+int rcvRFData(t_NetCallback pCallback)
+{
+  if (pCallback != NULL) {
+    appCallback = pCallback;
+  }
+
+  rxContinuous = FALSE;
+  armReceive(NO_ACK_DELAY);
+  return 0;
+}
+
+/****************************************************************************
+ * rcvRFDataContinuous
+ *
+ * Description: Like rcvRFData, but the radio is put back into receive
+ *              from the interrupt as soon as each packet has been
+ *              handled, so it is never off while the application is
+ *              busy.  Safe to call over and over, it only turns the
+ *              receiver on if it isn't already.  sendRFPacket and
+ *              sendRFPacketAsync turn receive off around the transmit.
+ *              stopReceive or rcvRFData end it.
+ *
+ *              The packet passed to the callback stays valid until the
+ *              packet after next arrives, the callback must not hold on
+ *              to it longer than that.
+ *
+ * Parms:       pCallback - function pointer to be called when packet received.
+ *
+ * Returns:     0 if success, 1 if error
+ ***************************************************************************/
+int rcvRFDataContinuous(t_NetCallback pCallback)
+{
+  if (pCallback != NULL) {
+    appCallback = pCallback;
+  }
+
+  rxContinuous = TRUE;
+
+  // An asynchronous send turns receive back on when it is done.
+  // Check txBusy first, once it reads FALSE the interrupt can't
+  // arm the receiver behind our back.
+  if (!txBusy && !rxArmed) {
+    armReceive(NO_ACK_DELAY);
+  }
+  return 0;
+}
+
+/****************************************************************************
+ * armReceive
+ *
+ * Description: Turns on the receiver into the next receive buffer
+ *
+ * Parms:       timeout - 13192 ticks until the receiver gives up, or
+ *                        NO_ACK_DELAY to wait forever
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void armReceive(UINT32 timeout)
+{
+  rx_packet_t *pRx;
+
+  // Setup the receive packet
+  pRx = &rxPacket[rxBufferIdx];
+  pRx->dataLength = 0;
+  pRx->data = &rxDataBuffer[rxBufferIdx][0];
+  pRx->maxDataLength = sizeof(t_NetPacket);
+  pRx->status = 0;
+
+  rxArmed = TRUE;
+  rxDone = FALSE;
+  MLME_RX_enable_request(pRx, timeout);          
+}
+
+/****************************************************************************
+ * MCPS_data_indication
+ *
+ * Description: SMAC (layer-2) will call this when packet arrives. This proc
+ *              will then check the contents of the packet.  Only if valid
+ *              packet will application be called.
+ *
+ * Parms:       rx_packet - pointer to received packet.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void MCPS_data_indication(rx_packet_t *rx_packet) 
+{
+  t_NetPacket *pPacket;
+  UINT8 lqi=0;
+
+  // Get pointer to data  
+  pPacket = (t_NetPacket *)rx_packet->data; 
+
+  // Link quality is for the frame just received, read it before
+  // the receiver goes back on
+  if (rx_packet->status == SUCCESS) {
+    lqi = 0xFF - MLME_link_quality();
+  }
+
+  // Radio is idle now.  In continuous receive the next frame goes
+  // into the other buffer, this one is handed to the application.
+  // SMAC has unmasked interrupts by now, so the receiver stays off
+  // until the packet is dealt with, otherwise the next frame's
+  // interrupt could land in the middle of it.
+  rxArmed = FALSE;
+  rxDone = TRUE;
+  if (rxContinuous) {
+    rxBufferIdx ^= 1;
+  }
+
+  if (rx_packet->status == SUCCESS) {
+    // Packet received, see if id string matches
+#ifndef MVMT_DEBUG
+    if (memcmp(NET_ID_STRING, pPacket->idString, NET_IDSTRING_STRLEN) == 0)
+#endif // all packets valid if debugging
+    {
+      // valid packet
+      linkSample(lqi);
+
+      switch (pPacket->msgType) {
+      case WAH_MVMT:
+      case WAH_ANGLE:
+        updateRFStats(pPacket);
+        break;
+
+      case WAH_ON:
+        // transmitter may have restarted, pick up its sequence
+        statsSynced = FALSE;
+        linkRxSynced = FALSE;
+        break;
+
+      case KEEPALIVE:
+        linkReceived(pPacket);
+        break;
+
+      case WAH_ACK:
+        ackSeen = TRUE;
+        linkReceived(pPacket);
+        break;
+      }
+
+      if (appCallback != NULL) {
+        appCallback(pPacket);
+      }
+
+    }// if good ack
+  }
+
+  // The callback may have sent, which turns receive back on itself
+  if (rxContinuous && !txBusy && !rxArmed) {
+    armReceive(NO_ACK_DELAY);
+  }
+}
+
+/****************************************************************************
+ * MLME_MC13192_reset_indication
+ *
+ * Description: resets 13192
+ *
+ * Parms:       nothing
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void MLME_MC13192_reset_indication() 
+{
+  // Notifies you that the MC13192 has been reset.
+  // Application must handle this here.
+  //
+  // The receiver is off after a reset, rcvRFDataContinuous
+  // will turn it back on.
+  rxArmed = FALSE;
+}
+
+/****************************************************************************
+ * MCPS_data_confirm
+ *
+ * Description: SMAC (layer-2) will call this from the interrupt when an
+ *              asynchronous send is done.  Keep it short.
+ *
+ * Parms:       status - SUCCESS, or ERROR if the send was aborted
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void MCPS_data_confirm(__uint8__ status)
+{
+  (void)status;
+
+  txBusy = FALSE;
+  if (rxContinuous) {
+    armReceive(NO_ACK_DELAY);
+  }
+}
+
+
+/****************************************************************************
+ * setRFChannel
+ *
+ * Description: sets the RF Channel and power in use.  SMAC only writes 
+ *              the 13192 registers that changed, so calling this on every
+ *              wake costs nothing unless the 13192 was reset.
+ *
+ * Parms:       nothing
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void setRFChannel()
+{
+
+  // Set tx channel  
+  MLME_set_channel_request(rfChannel);
+
+  // Set power setting
+  MLME_MC13192_PA_output_adjust(rfPower);
+}
+
+/****************************************************************************
+ * changeRFChannel
+ *
+ * Description: Moves to another RF channel.  The receiver must not be on.
+ *
+ * Parms:       channel - 0 to PHY_NUM_CHANNELS-1
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void changeRFChannel(UINT8 channel)
+{
+  if (channel < PHY_NUM_CHANNELS) {
+    rfChannel = channel;
+    setRFChannel();
+  }
+}
+
+/****************************************************************************
+ * getRFChannel
+ *
+ * Description: Channel in use
+ *
+ * Parms:       nothing
+ *
+ * Returns:     channel, 0 to PHY_NUM_CHANNELS-1
+ ***************************************************************************/
+UINT8 getRFChannel(void)
+{
+  return rfChannel;
+}
+
+/****************************************************************************
+ * selectQuietRFChannel
+ *
+ * Description: Site survey for the transmitter.  Makes sure the receiver
+ *              can be heard, measures the energy on every survey channel,
+ *              and if one is clearly quieter than the channel in use
+ *              moves there together with the receiver.  The energy of
+ *              each channel is then reported to the receiver in 
+ *              WAH_ENERGY packets.  Blocks for up to a few hundred ms.
+ *              The 13192 has to be awake.
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if the receiver answered
+ ***************************************************************************/
+BOOL selectQuietRFChannel(void)
+{
+  UINT8 i, channel, best;
+
+  stopReceive();
+
+  if (!findReceiver()) {
+    // nobody to agree on a channel with, stay put
+    return FALSE;
+  }
+
+  surveyRFChannels();
+
+  // Quietest channel, ties go to the lowest
+  best = rfChannel;
+  for (i=0; i<NUM_SURVEY_CHANNELS; i++) {
+    channel = surveyChannel(i);
+    if (channelEnergy[channel] > channelEnergy[best]) {
+      best = channel;
+    }
+  }
+
+  // Only move for a real improvement, not measurement noise
+  if (best != rfChannel && 
+      channelEnergy[best] >= channelEnergy[rfChannel] + NET_SURVEY_MARGIN) {
+    if (!moveRFChannel(best)) {
+      return FALSE;
+    }
+  }
+
+  // Report to the receiver, the last packet is the channel in use
+  for (i=0; i<NUM_SURVEY_CHANNELS; i++) {
+    channel = surveyChannel(i);
+    if (channel != rfChannel) {
+      sendRFEnergy(channel);
+    }
+  }
+  sendRFEnergy(rfChannel);
+
+  return TRUE;
+}
+
+/****************************************************************************
+ * findReceiver
+ *
+ * Description: Checks the receiver answers a keepalive on the channel 
+ *              in use.  If it doesn't, it may have been restarted, so
+ *              look for it on the default channel.
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if the receiver answered, the channel in use is
+ *              where it was found
+ ***************************************************************************/
+static BOOL findReceiver(void)
+{
+  UINT8 oldChannel = rfChannel;
+
+  if (sendRFMessage(KEEPALIVE) && waitRFAck()) {
+    return TRUE;
+  }
+
+  if (rfChannel != NET_DEFAULT_CHANNEL) {
+    changeRFChannel(NET_DEFAULT_CHANNEL);
+    if (sendRFMessage(KEEPALIVE) && waitRFAck()) {
+      return TRUE;
+    }
+    changeRFChannel(oldChannel);
+  }
+
+  return FALSE;
+}
+
+/****************************************************************************
+ * surveyRFChannels
+ *
+ * Description: Energy detect on each survey channel.  Wi-Fi comes in
+ *              bursts, so the loudest of several readings is kept.  
+ *              Leaves the channel in use selected.
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void surveyRFChannels(void)
+{
+  UINT8 i, sample, channel, energy;
+
+  for (i=0; i<PHY_NUM_CHANNELS; i++) {
+    channelEnergy[i] = 0;
+  }
+
+  for (i=0; i<NUM_SURVEY_CHANNELS; i++) {
+    channel = surveyChannel(i);
+    MLME_set_channel_request(channel);
+
+    channelEnergy[channel] = 0xFF;
+    for (sample=0; sample<NET_SURVEY_SAMPLES; sample++) {
+      energy = MLME_energy_detect();
+      if (energy < channelEnergy[channel]) {
+        channelEnergy[channel] = energy;
+      }
+    }
+  }
+
+  setRFChannel();
+}
+
+/****************************************************************************
+ * moveRFChannel
+ *
+ * Description: Moves the transmitter and receiver to a new channel.  The
+ *              receiver acks a WAH_CHANNEL packet and then changes.  If 
+ *              no ack arrives the ack may be what was lost, so look for
+ *              the receiver on the new channel before going back.
+ *
+ * Parms:       channel - new channel
+ *
+ * Returns:     TRUE if both moved, FALSE if both are still on the old one
+ ***************************************************************************/
+static BOOL moveRFChannel(UINT8 channel)
+{
+  UINT8 oldChannel = rfChannel;
+  UINT8 tries;
+
+  netPacket.netData[0] = channel;
+  for (tries=0; tries<NET_CHANNEL_TRIES; tries++) {
+    if (sendRFMessage(WAH_CHANNEL) && waitRFAck()) {
+      changeRFChannel(channel);
+      return TRUE;
+    }
+  }
+
+  changeRFChannel(channel);
+  if (sendRFMessage(KEEPALIVE) && waitRFAck()) {
+    return TRUE;
+  }
+
+  changeRFChannel(oldChannel);
+  return FALSE;
+}
+
+/****************************************************************************
+ * waitRFAck
+ *
+ * Description: Listens for a WAH_ACK for up to NET_ACK_TIMEOUT_TICKS.
+ *              Other packets are passed on to the application as usual.
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if the ack arrived
+ ***************************************************************************/
+static BOOL waitRFAck(void)
+{
+  static t_time start, now;
+  static UINT32 waited;
+
+  rxContinuous = FALSE;
+  ackSeen = FALSE;
+  HAL_getTicks(&start);
+
+  for (;;) {
+    HAL_getTicks(&now);
+    waited = (now - start) & MAX_TIME_VALUE;
+    if (ackSeen || waited + ACK_GUARD_TICKS >= NET_ACK_TIMEOUT_TICKS) {
+      break;
+    }
+
+    // Listen for the rest of the time, the 13192 times out by 
+    // itself so there is always an interrupt to wait for.  Too
+    // short a timeout could pass before it is programmed, hence
+    // the guard above.
+    armReceive(NET_ACK_TIMEOUT_TICKS - waited);
+
+    // Sleep rather than spin.  rxDone is checked with interrupts 
+    // masked, WAIT unmasks them as it stops so an interrupt that 
+    // came in after the check still wakes it.
+    DisableInterrupts;
+    while (!rxDone) {
+      MCU_LOW_POWER_WHILE;
+      DisableInterrupts;
+    }
+    EnableInterrupts;
+  }
+
+  stopReceive();
+  return ackSeen;
+}
+
+/****************************************************************************
+ * sendRFPacket
+ *
+ * Description: Sends a complete packet to receiver.  SMAC will do a
+ *              low power while during the transmission.  Waits for an
+ *              asynchronous send still in the air to finish first.
+ *
+ * Parms:       packet - pointer to outgoing layer 3 packet
+ *
+ * Returns:     1 if success, 0 if fail
+ ***************************************************************************/
+int sendRFPacket(t_NetPacket *packet)
+{
+  int retcode = TRUE;
+
+  while (txBusy) {
+    MCU_LOW_POWER_WHILE;
+  }
+
+  // Setup packet to be passed to SMAC
+  txPacket.data = (UINT8 *)packet; 
+  txPacket.dataLength = sizeof(t_NetPacket);
+
+  // SMAC won't transmit while receiving
+  if (rxArmed) {
+    MLME_RX_disable_request();
+    rxArmed = FALSE;
+  }
+
+  // Send the packet
+  if (MCPS_data_request(&txPacket) != SUCCESS) {
+    // problem occured
+    retcode = FALSE;
+  }
+
+  if (rxContinuous) {
+    armReceive(NO_ACK_DELAY);
+  }
+
+  return retcode;
+}
+
+/****************************************************************************
+ * sendRFPacketAsync
+ *
+ * Description: Starts sending a packet and returns right away, the radio
+ *              finishes it in the background (about 1ms on the air) and
+ *              MCPS_data_confirm clears the busy flag.  The packet is
+ *              copied to the MC13192 before returning, so it may be reused.
+ *              Only one send can be in the air, another one is refused
+ *              rather than queued since the newest motion frame makes an
+ *              older one worthless anyway.
+ *
+ * Parms:       packet - pointer to outgoing layer 3 packet
+ *
+ * Returns:     1 if started, 0 if busy or fail
+ ***************************************************************************/
+int sendRFPacketAsync(t_NetPacket *packet)
+{
+  if (txBusy) {
+    return FALSE;
+  }
+
+  // Setup packet to be passed to SMAC
+  txPacket.data = (UINT8 *)packet; 
+  txPacket.dataLength = sizeof(t_NetPacket);
+
+  // SMAC won't transmit while receiving
+  if (rxArmed) {
+    MLME_RX_disable_request();
+    rxArmed = FALSE;
+  }
+
+  // Set busy first, the confirm can come before the request returns
+  txBusy = TRUE;
+  if (MCPS_data_request_async(&txPacket) != SUCCESS) {
+    txBusy = FALSE;
+    if (rxContinuous) {
+      armReceive(NO_ACK_DELAY);
+    }
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/****************************************************************************
+ * isRFSendBusy
+ *
+ * Description: Tells if an asynchronous send is still in the air
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if busy
+ ***************************************************************************/
+BOOL isRFSendBusy(void)
+{
+  return txBusy;
+}
+
+/****************************************************************************
+ * sendRFMessage
+ *
+ * Description: Sends a status message to receiver.  Returns immediately and 
+ *             leaves the RF receiver on, waiting for packet.  It is the 
+ *             responsibility of the application to monitor received packets
+ *             and to handle timing out.  The application MUST NOT go into 
+ *             sleep mode until a packet is received (or timeout).  Otherwise 
+ *             the return packet may be lost.
+ *
+ * Parms:       msgType - layer 3 message type
+ *
+ * Returns:     1 if success, 0 if fail
+ ***************************************************************************/
+int sendRFMessage(t_NetMsgType msgType)
+{
+  int retcode = TRUE;
+
+  // Setup the data packet
+  // NOTE: header.idString is already setup for speed
+  netPacket.msgType = msgType;
+
+  if (msgType == KEEPALIVE || msgType == WAH_ACK) {
+    setLinkReport(&netPacket);
+  }
+
+  // Initialize data section
+  //memset(netPacket.data, 0, sizeof(netPacket.data));
+
+  retcode = sendRFPacket(&netPacket);  
+  return retcode;
+}
+
+/****************************************************************************
+ * sendRFAngle
+ *
+ * Description: Sends the pedal angle to the receiver in a WAH_ANGLE 
+ *              packet with the next sequence number.  Doesn't wait for
+ *              the send to finish, see sendRFPacketAsync.
+ *
+ * Parms:       angle - pedal angle in tenths of a degree
+ *
+ * Returns:     1 if started, 0 if busy or fail
+ ***************************************************************************/
+int sendRFAngle(INT16 angle)
+{
+  // NOTE: header.idString is already setup for speed
+  netPacket.msgType = WAH_ANGLE;
+  netPacket.netData[NET_ANGLE_MSB] = (UINT8)((UINT16)angle >> 8);
+  netPacket.netData[NET_ANGLE_LSB] = (UINT8)angle;
+
+  return sendMotionPacket(&netPacket);
+}
+
+/****************************************************************************
+ * sendRFMovement
+ *
+ * Description: Sends raw accelerometer readings to the receiver in a 
+ *              WAH_MVMT packet.  Doesn't wait for the send to finish, 
+ *              see sendRFPacketAsync.
+ *
+ * Parms:       x, y, z - accelerometer readings
+ *
+ * Returns:     1 if started, 0 if busy or fail
+ ***************************************************************************/
+int sendRFMovement(t_NetData x, t_NetData y, t_NetData z)
+{
+  netPacket.msgType = WAH_MVMT;
+  netPacket.netData[0] = x;
+  netPacket.netData[1] = y;
+  netPacket.netData[2] = z;
+
+  return sendMotionPacket(&netPacket);
+}
+
+/****************************************************************************
+ * sendRFEnergy
+ *
+ * Description: Reports a channel's site survey reading to the receiver
+ *              in a WAH_ENERGY packet.
+ *
+ * Parms:       channel - channel surveyed
+ *
+ * Returns:     1 if success, 0 if fail
+ ***************************************************************************/
+int sendRFEnergy(UINT8 channel)
+{
+  netPacket.netData[NET_ENERGY_CHANNEL] = channel;
+  netPacket.netData[NET_ENERGY_LEVEL]   = channelEnergy[channel];
+  netPacket.netData[NET_ENERGY_IN_USE]  = (channel == rfChannel);
+
+  return sendRFMessage(WAH_ENERGY);
+}
+
+/****************************************************************************
+ * sendMotionPacket
+ *
+ * Description: Fills in the transaction number and send time of a
+ *              motion frame and starts sending it.  The transaction
+ *              number is only used up if the send starts, the receiver
+ *              would count a refused frame's number as a lost packet.
+ *
+ * Parms:       packet - outgoing motion frame
+ *
+ * Returns:     1 if started, 0 if busy or fail
+ ***************************************************************************/
+static int sendMotionPacket(t_NetPacket *packet)
+{
+  static t_time now;
+
+  if (txBusy) {
+    return FALSE;
+  }
+
+  HAL_getTicks(&now);
+
+  packet->transNum = transNum;
+  packet->timestamp[0] = (UINT8)(now >> 16);
+  packet->timestamp[1] = (UINT8)(now >> 8);
+  packet->timestamp[2] = (UINT8)now;
+
+  if (!sendRFPacketAsync(packet)) {
+    return FALSE;
+  }
+
+  (void)getNexTransNum();
+  return TRUE;
+}
+
+/****************************************************************************
+ * getNexTransNum
+ *
+ * Description: Next transaction (sequence) number for outgoing packets
+ *
+ * Parms:       none
+ *
+ * Returns:     transaction number, 0 to MAX_NET_TRANSNUM-1
+ ***************************************************************************/
+t_NetTransNum getNexTransNum(void)
+{
+  t_NetTransNum thisNum = transNum;
+
+  if (++transNum >= MAX_NET_TRANSNUM) {
+    transNum = 0;
+  }
+
+  return thisNum;
+}
+
+/****************************************************************************
+ * updateRFStats
+ *
+ * Description: Updates the motion frame statistics from a received frame.
+ *              A transaction number up to half the range ahead of the one
+ *              expected means frames were lost, anything behind it is a 
+ *              duplicate or arrived out of order.
+ *
+ * Parms:       packet - received motion frame
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void updateRFStats(t_NetPacket *packet)
+{
+  static t_time rxTime, txTime, transit;
+  static UINT32 change;
+  t_NetTransNum ahead;
+
+  HAL_getTicks(&rxTime);
+  txTime = ((t_time)packet->timestamp[0] << 16) |
+           ((t_time)packet->timestamp[1] << 8) |
+           packet->timestamp[2];
+
+  // Clocks on each side are free running, only the change in 
+  // transit time from one frame to the next means anything
+  transit = (rxTime - txTime) & MAX_TIME_VALUE;
+
+  statAdd(NET_STAT_RECEIVED, 1);
+
+  if (!statsSynced) {
+    statsSynced = TRUE;
+    nextTransNum = (packet->transNum + 1) & (MAX_NET_TRANSNUM - 1);
+    lastTransit = transit;
+    return;
+  }
+
+  ahead = (packet->transNum - nextTransNum) & (MAX_NET_TRANSNUM - 1);
+
+  if (ahead < MAX_NET_TRANSNUM/2) {
+    if (ahead > 0) {
+      statAdd(NET_STAT_LOST, ahead);
+      statAdd(NET_STAT_GAPS, 1);
+    }
+    nextTransNum = (packet->transNum + 1) & (MAX_NET_TRANSNUM - 1);
+
+    // |change in transit time|, the 24 bit time wraps
+    change = (transit - lastTransit) & MAX_TIME_VALUE;
+    if (change > (MAX_TIME_VALUE >> 1)) {
+      change = (MAX_TIME_VALUE + 1) - change;
+    }
+    change = getMin(change, 0xFFFF);
+    lastTransit = transit;
+
+    jitterSum -= jitterSum >> NET_JITTER_SHIFT;
+    jitterSum += change;
+    netStats[NET_STAT_JITTER] = (UINT16)getMin(jitterSum >> NET_JITTER_SHIFT, 0xFFFF);
+    if (change > netStats[NET_STAT_JITTER_MAX]) {
+      netStats[NET_STAT_JITTER_MAX] = (UINT16)change;
+    }
+  } else if (packet->transNum == ((nextTransNum - 1) & (MAX_NET_TRANSNUM - 1))) {
+    statAdd(NET_STAT_DUPLICATES, 1);
+  } else {
+    // counted as lost when the later frame showed up
+    statAdd(NET_STAT_REORDERED, 1);
+    if (netStats[NET_STAT_LOST] > 0) {
+      netStats[NET_STAT_LOST]--;
+    }
+  }
+}
+
+/****************************************************************************
+ * statAdd
+ *
+ * Description: Adds to a statistic without wrapping
+ *
+ * Parms:       statId - statistic
+ *              count  - amount to add
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void statAdd(UINT8 statId, UINT16 count)
+{
+  if (netStats[statId] > 0xFFFF - count) {
+    netStats[statId] = 0xFFFF;
+  } else {
+    netStats[statId] += count;
+  }
+}
+
+/****************************************************************************
+ * getRFStat
+ *
+ * Description: Gets a motion frame statistic
+ *
+ * Parms:       statId - NET_STAT_xxx
+ *
+ * Returns:     value, 0 if statId is not valid
+ ***************************************************************************/
+UINT16 getRFStat(UINT8 statId)
+{
+  UINT16 value;
+
+  if (statId >= MAX_NET_STATS) {
+    return 0;
+  }
+
+  // the receive interrupt counts, don't read half an update
+  CRITICAL_ENTER(statsCcr);
+  value = netStats[statId];
+  CRITICAL_EXIT(statsCcr);
+
+  return value;
+}
+
+/****************************************************************************
+ * resetRFStats
+ *
+ * Description: Clears the motion frame statistics
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void resetRFStats(void)
+{
+  UINT8 i;
+
+  for (i=0; i<MAX_NET_STATS; i++) {
+    netStats[i] = 0;
+  }
+  jitterSum = 0;
+  statsSynced = FALSE;
+  linkMvmtLostBase = 0;
+}
+
+/****************************************************************************
+ * linkSample
+ *
+ * Description: Adds the link quality of the frame just received to the
+ *              local link report.  Called from the receive interrupt.
+ *
+ * Parms:       lqi - of the frame, see t_NetLinkReport
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void linkSample(UINT8 lqi)
+{
+  if (linkSamples == 0) {
+    linkLqiMin = lqi;
+    linkLqiMax = lqi;
+    linkLqiSum = 0;
+  } else {
+    if (lqi < linkLqiMin) {
+      linkLqiMin = lqi;
+    }
+    if (lqi > linkLqiMax) {
+      linkLqiMax = lqi;
+    }
+  }
+
+  // stop at 255 frames so the sum fits, plenty for an average
+  if (linkSamples < 0xFF) {
+    linkLqiSum += lqi;
+    linkSamples++;
+  }
+}
+
+/****************************************************************************
+ * linkReceived
+ *
+ * Description: Handles the link report in a received KEEPALIVE or
+ *              WAH_ACK.  Keepalives missing in the sequence, or acks
+ *              that never came back, are counted as lost.
+ *
+ * Parms:       packet - KEEPALIVE or WAH_ACK
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void linkReceived(t_NetPacket *packet)
+{
+  t_NetTransNum missed;
+
+  if (packet->msgType == KEEPALIVE) {
+    // a big jump back is a restarted transmitter, not a loss
+    missed = packet->transNum - (t_NetTransNum)(linkRxSeq + 1);
+    if (linkRxSynced && missed < 0x80) {
+      linkLost = (UINT8)getMin(linkLost + missed, 0xFF);
+    }
+    linkRxSynced = TRUE;
+    linkRxSeq = packet->transNum;
+  } else if (packet->transNum == linkTxSeq) {
+    linkAckPending = FALSE;
+  }
+
+  linkPeer.lqiMin   = packet->timestamp[NET_LINK_LQI_MIN];
+  linkPeer.lqiAvg   = packet->timestamp[NET_LINK_LQI_AVG];
+  linkPeer.lqiMax   = packet->timestamp[NET_LINK_LQI_MAX];
+  linkPeer.linkLost = packet->netData[NET_LINK_LOST];
+  linkPeer.mvmtLost = packet->netData[NET_LINK_MVMT_LOST];
+  linkPeer.samples  = packet->netData[NET_LINK_SAMPLES];
+  linkPeerFresh = TRUE;
+}
+
+/****************************************************************************
+ * setLinkReport
+ *
+ * Description: Puts the local link report in an outgoing KEEPALIVE or
+ *              WAH_ACK and starts a new one.
+ *
+ * Parms:       packet - KEEPALIVE or WAH_ACK being sent
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void setLinkReport(t_NetPacket *packet)
+{
+  t_NetLinkReport report;
+
+  // the receive interrupt updates the same counts
+  CRITICAL_ENTER(linkCcr);
+
+  if (packet->msgType == KEEPALIVE) {
+    // the last one was never answered
+    if (linkAckPending && linkLost < 0xFF) {
+      linkLost++;
+    }
+    linkAckPending = TRUE;
+    packet->transNum = ++linkTxSeq;
+  } else {
+    packet->transNum = linkRxSeq;
+  }
+
+  // send it and start over
+  linkLocal(&report);
+  linkSamples = 0;
+  linkLost = 0;
+  linkMvmtLostBase = netStats[NET_STAT_LOST];
+  CRITICAL_EXIT(linkCcr);
+
+  packet->timestamp[NET_LINK_LQI_MIN] = report.lqiMin;
+  packet->timestamp[NET_LINK_LQI_AVG] = report.lqiAvg;
+  packet->timestamp[NET_LINK_LQI_MAX] = report.lqiMax;
+  packet->netData[NET_LINK_LOST]      = report.linkLost;
+  packet->netData[NET_LINK_MVMT_LOST] = report.mvmtLost;
+  packet->netData[NET_LINK_SAMPLES]   = report.samples;
+}
+
+/****************************************************************************
+ * getRFLinkLocal
+ *
+ * Description: Link report of this side since the last one sent.
+ *
+ * Parms:       report - filled in
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void getRFLinkLocal(t_NetLinkReport *report)
+{
+  CRITICAL_ENTER(linkCcr);
+  linkLocal(report);
+  CRITICAL_EXIT(linkCcr);
+}
+
+/****************************************************************************
+ * linkLocal
+ *
+ * Description: getRFLinkLocal without the interrupt locking.
+ *
+ * Parms:       report - filled in
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void linkLocal(t_NetLinkReport *report)
+{
+  if (linkSamples == 0) {
+    report->lqiMin = 0;
+    report->lqiAvg = 0;
+    report->lqiMax = 0;
+  } else {
+    report->lqiMin = linkLqiMin;
+    report->lqiAvg = (UINT8)(linkLqiSum / linkSamples);
+    report->lqiMax = linkLqiMax;
+  }
+  report->samples  = linkSamples;
+  report->linkLost = linkLost;
+
+  // reordered frames take back a loss, so this can go below the base
+  if (netStats[NET_STAT_LOST] < linkMvmtLostBase) {
+    report->mvmtLost = 0;
+  } else {
+    report->mvmtLost = (UINT8)getMin(netStats[NET_STAT_LOST] - linkMvmtLostBase, 0xFF);
+  }
+}
+
+/****************************************************************************
+ * getRFLinkPeer
+ *
+ * Description: Last link report received from the other side.
+ *
+ * Parms:       report - filled in
+ *
+ * Returns:     TRUE if it is new since the last call
+ ***************************************************************************/
+BOOL getRFLinkPeer(t_NetLinkReport *report)
+{
+  BOOL fresh;
+
+  CRITICAL_ENTER(linkCcr);
+  *report = linkPeer;
+  fresh = linkPeerFresh;
+  linkPeerFresh = FALSE;
+  CRITICAL_EXIT(linkCcr);
+
+  return fresh;
+}
+
+/****************************************************************************
+ * adjustRFPower
+ *
+ * Description: Transmit power control loop, called by the transmitter
+ *              when a keepalive is acked or the ack doesn't come.  Runs 
+ *              at the lowest PA level that keeps the receiver's link
+ *              report comfortably above its sensitivity.
+ *
+ * Parms:       acked - TRUE if the ack arrived, FALSE if it timed out
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void adjustRFPower(BOOL acked)
+{
+  t_NetLinkReport report;
+  UINT8 power = rfPower;
+
+  if (!acked) {
+    // lost the receiver, get it back now and settle down later
+    power = (UINT8)getMin(power + NET_POWER_ATTACK, NET_POWER_MAX);
+    powerGoodReports = 0;
+  } else if (getRFLinkPeer(&report) && report.samples > 0) {
+    if (report.lqiMin < NET_POWER_LQI_LOW || report.linkLost > 0 ||
+        report.mvmtLost > NET_POWER_LOSS_LIMIT) {
+      if (power < NET_POWER_MAX) {
+        power++;
+      }
+      powerGoodReports = 0;
+    } else if (report.lqiMin > NET_POWER_LQI_HIGH) {
+      if (++powerGoodReports >= NET_POWER_DOWN_REPORTS) {
+        if (power > NET_POWER_MIN) {
+          power--;
+        }
+        powerGoodReports = 0;
+      }
+    } else {
+      // in the band, leave it alone
+      powerGoodReports = 0;
+    }
+  }
+
+  if (power != rfPower) {
+    rfPower = power;
+    MLME_MC13192_PA_output_adjust(rfPower);
+  }
+}
+
+/****************************************************************************
+ * getRFPower
+ *
+ * Description: PA level in use
+ *
+ * Parms:       nothing
+ *
+ * Returns:     NET_POWER_MIN to NET_POWER_MAX
+ ***************************************************************************/
+UINT8 getRFPower(void)
+{
+  return rfPower;
+}
+
+/****************************************************************************
+ * sendRFStat
+ *
+ * Description: Answers a WAH_STATS_QUERY
+ *
+ * Parms:       statId - NET_STAT_xxx asked for
+ *
+ * Returns:     1 if success, 0 if fail
+ ***************************************************************************/
+int sendRFStat(UINT8 statId)
+{
+  UINT16 value;
+
+  value = getRFStat(statId);
+
+  netPacket.msgType = WAH_STATS;
+  netPacket.netData[0] = statId;
+  netPacket.netData[1] = (UINT8)(value >> 8);
+  netPacket.netData[2] = (UINT8)value;
+
+  return sendRFPacket(&netPacket);  
+}
@@ -1,55 +1,164 @@
-#ifndef __NET_H
-#define __NET_H
-
-#include "common_def.h"
-#include "pub_def.h"
-
-// Max size of our packets
-#define MAX_PACKET_BUFFER 20
-#define POWER_SETTING NOMINAL_POWER
-
-// How long to delay waiting for acknowledgement 
-#define ACK_DELAY_COUNT 0xB000
-#define NO_ACK_DELAY    0
-
-
-// Data structure for holding channels to scan and associated
-// power levels during the scan
-typedef struct {
-  UINT8 channel;
-  UINT8 power;
-}t_powerScan;
-
-typedef UINT8 t_NetTransNum; 
-typedef UINT8 t_NetData;
-typedef UINT8 t_NetMsgType;
-
-#define NET_IDSTRING_STRLEN   3
-#define NET_ID_STRING         "WAH"
-#define MAX_NET_TRANSNUM      128
-#define MAX_NET_DATA          3
-
-enum {
-  KEEPALIVE, WAH_ON, WAH_OFF, WAH_MVMT, WAH_ACK
-};
-
-typedef struct {
-  UINT8         idString[NET_IDSTRING_STRLEN];
-  t_NetMsgType  msgType;
-  UINT8 netData[MAX_NET_DATA];
-}t_NetPacket;
-
-
-// Callback function from net to application
-typedef void (*t_NetCallback) (t_NetPacket *data);
-
-int sendRFMessage(t_NetMsgType msgType);
-int sendRFPacket(t_NetPacket *packet);
-int rcvRFData(t_NetCallback pCallback);
-int stopReceive(void);
-void selectNextRFChannel();
-void setRFChannel();
-
-
-#endif
-
+#ifndef __NET_H
+#define __NET_H
+
+#include "common_def.h"
+#include "pub_def.h"
+
+// Max size of our packets
+#define MAX_PACKET_BUFFER 20
+
+// Receive buffers, ping-pong for continuous receive
+#define NET_RX_BUFFERS    2
+#define POWER_SETTING NOMINAL_POWER
+
+// How long to delay waiting for acknowledgement 
+#define ACK_DELAY_COUNT 0xB000
+#define NO_ACK_DELAY    0
+
+// Site survey.  Both ends start on NET_DEFAULT_CHANNEL, the 
+// transmitter picks the quietest channel and moves the receiver
+// there with a WAH_CHANNEL packet.  Define NET_SURVEY_ALL_CHANNELS
+// to survey all 16 channels, otherwise only the list in net.c.
+#define NET_SURVEY_ALL_CHANNELS
+#define NET_DEFAULT_CHANNEL   0
+#define NET_SURVEY_SAMPLES    4     // energy readings per channel
+#define NET_SURVEY_MARGIN     6     // 3dB quieter before moving
+#define NET_CHANNEL_TRIES     3     // WAH_CHANNEL sends before giving up
+#define NET_ACK_TIMEOUT_TICKS 5000  // 20ms of 13192 ticks (see HAL.h)
+
+typedef UINT8 t_NetTransNum; 
+typedef UINT8 t_NetData;
+typedef UINT8 t_NetMsgType;
+
+#define NET_IDSTRING_STRLEN   3
+#define NET_ID_STRING         "WAH"
+#define MAX_NET_TRANSNUM      128
+#define MAX_NET_DATA          3
+
+enum {
+  KEEPALIVE, WAH_ON, WAH_OFF, WAH_MVMT, WAH_ACK, 
+  WAH_ANGLE,        // pedal angle already calculated, see below
+  WAH_STATS_QUERY,  // ask for a motion frame statistic
+  WAH_STATS,        // answer to WAH_STATS_QUERY
+  WAH_CHANNEL,      // move to channel netData[0], ack first
+  WAH_ENERGY        // site survey reading, see below
+};
+
+// WAH_ENERGY packet layout in netData.  The level is the raw
+// energy detect reading, -(level/2) dBm, so bigger is quieter.
+#define NET_ENERGY_CHANNEL    0
+#define NET_ENERGY_LEVEL      1
+#define NET_ENERGY_IN_USE     2     // 1 for the channel picked
+
+// Define to have the transmitter calculate the pedal angle and
+// send WAH_ANGLE packets instead of raw accelerometer readings in
+// WAH_MVMT packets.  The receiver understands both.
+#define NET_ANGLE_PACKETS
+
+// WAH_ANGLE packet layout in netData.  The angle is in tenths of
+// a degree (see fixed_trig.h), MSB first.
+#define NET_ANGLE_MSB         0
+#define NET_ANGLE_LSB         1
+#define getNetAngle(p)        ((INT16)(((UINT16)(p)->netData[NET_ANGLE_MSB] << 8) | (p)->netData[NET_ANGLE_LSB]))
+
+// Motion frames (WAH_MVMT, WAH_ANGLE) carry a transaction number
+// that counts 0 to MAX_NET_TRANSNUM-1 and wraps, and the 24 bit 
+// MC13192 time (MSB first) when the frame was sent.  The receiving
+// side uses them to keep the motion frame statistics.
+#define NET_TIMESTAMP_LEN     3
+
+typedef struct {
+  UINT8         idString[NET_IDSTRING_STRLEN];
+  t_NetMsgType  msgType;
+  t_NetTransNum transNum;                      // motion frames, link reports
+  UINT8         timestamp[NET_TIMESTAMP_LEN];  // motion frames, link report LQI
+  UINT8 netData[MAX_NET_DATA];
+}t_NetPacket;
+
+// Motion frame statistics, counted by the receiving side.  All 
+// saturate at 0xFFFF.  Jitter is the RFC 3550 style inter-arrival 
+// jitter, the smoothed change in (receive time - send time) from
+// one frame to the next, in MC13192 ticks (see TIME_PRESCALE).
+//
+// WAH_STATS_QUERY has the statistic in netData[0].  The WAH_STATS 
+// answer has the statistic in netData[0] and the value MSB first
+// in netData[1], netData[2].
+enum {
+  NET_STAT_RECEIVED,    // motion frames received
+  NET_STAT_LOST,        // frames missing in the sequence
+  NET_STAT_GAPS,        // times one or more frames went missing
+  NET_STAT_DUPLICATES,  // same frame received again
+  NET_STAT_REORDERED,   // frame arrived after a later one
+  NET_STAT_JITTER,      // average jitter
+  NET_STAT_JITTER_MAX,  // worst jitter
+  MAX_NET_STATS
+};
+
+// Link report.  KEEPALIVE and WAH_ACK have no motion header, so
+// they carry the sender's view of the link since its last report
+// instead.  transNum counts keepalives, the ack echoes the one it
+// answers.  The LQI is 255 - the 13192 link quality reading, so
+// bigger is better and dBm = (lqi - 255) / 2.  The counts
+// saturate at 255.
+//
+// The LQI of the frames received goes in timestamp:
+#define NET_LINK_LQI_MIN      0
+#define NET_LINK_LQI_AVG      1
+#define NET_LINK_LQI_MAX      2
+// and the counts in netData:
+#define NET_LINK_LOST         0     // keepalives (or their acks) that never arrived
+#define NET_LINK_MVMT_LOST    1     // motion frames lost, receiver only
+#define NET_LINK_SAMPLES      2     // frames the LQI was taken from
+
+typedef struct {
+  UINT8 lqiMin;
+  UINT8 lqiAvg;
+  UINT8 lqiMax;
+  UINT8 linkLost;
+  UINT8 mvmtLost;
+  UINT8 samples;
+} t_NetLinkReport;
+
+// Transmit power control.  The transmitter starts at POWER_SETTING
+// and steps the 13192 PA level (0-15) from the receiver's link 
+// report in each ack.  One poor report steps up, it takes several 
+// good ones in a row to step down, and in between nothing changes.
+// A missing ack is the fast attack, several steps up at once.  
+// LQI is as in t_NetLinkReport, the receiver loses packets around
+// lqi 70 (-92dBm).
+#define NET_POWER_MIN         0
+#define NET_POWER_MAX         15
+#define NET_POWER_ATTACK      4     // steps up when an ack is missed
+#define NET_POWER_LQI_LOW     100   // -77dBm, worst frame below steps up
+#define NET_POWER_LQI_HIGH    120   // -67dBm, worst frame above may step down
+#define NET_POWER_DOWN_REPORTS 3    // good reports in a row to step down
+#define NET_POWER_LOSS_LIMIT  2     // motion frames lost per report
+
+// Callback function from net to application
+typedef void (*t_NetCallback) (t_NetPacket *data);
+
+int sendRFMessage(t_NetMsgType msgType);
+int sendRFPacket(t_NetPacket *packet);
+int sendRFPacketAsync(t_NetPacket *packet);
+BOOL isRFSendBusy(void);
+int sendRFAngle(INT16 angle);
+int sendRFMovement(t_NetData x, t_NetData y, t_NetData z);
+int sendRFStat(UINT8 statId);
+int sendRFEnergy(UINT8 channel);
+UINT16 getRFStat(UINT8 statId);
+void resetRFStats(void);
+void getRFLinkLocal(t_NetLinkReport *report);
+BOOL getRFLinkPeer(t_NetLinkReport *report);
+void adjustRFPower(BOOL acked);
+UINT8 getRFPower(void);
+int rcvRFData(t_NetCallback pCallback);
+int rcvRFDataContinuous(t_NetCallback pCallback);
+int stopReceive(void);
+void setRFChannel();
+void changeRFChannel(UINT8 channel);
+UINT8 getRFChannel(void);
+BOOL selectQuietRFChannel(void);
+
+
+#endif
+
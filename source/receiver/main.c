@@ -1,236 +1,478 @@
-/****************************************************************************
-* main.c
-* 
-* Author: Bill Bishop - Sixth Sensor
-* Title: 	main.c
-* 
-* This is the main file for the Remote Control Wah Pedal Receiver.
-* The receiver controls the wah pedal hardware based on values 
-* given from transmitter.
-*
-* The RF channel is constantly monitored.  When a keepalive packet is
-* received we send an ack.  When a movement packet is received it is
-* translated into a wah pedal setting.  The translation is just a
-* trig function to calculate the angle of the pedal based on accelerometer
-* values.
-*
-****************************************************************************/
-#include <hidef.h> /* for EnableInterrupts macro */
-#include <MC9S08GT60.h> /* include peripheral declarations */
-#include "simple_mac.h"
-#include "mcu_hw_config.h"
-#include "MC13192_hw_config.h"
-#include "SCI.h"
-#include "drivers.h"
-#include "sard_board.h"
-#include "HAL.h"
-#include "net.h"
-#include "statemach.h"
-#include "wahPedal.h"
-#include "trigtables.h"
-
-// Number of packets to toss while waiting for
-// accelerometer readings to settle down after the
-// user turns on the device
-#define NUM_TOSS_PACKETS  2
-
-void alarmRFProblem(BOOL alarm);
-void runLed(BOOL alarm);
-void runLedFlash();
-int getWahStep(UINT8 wahStep, const t_NetData accReading, const t_NetData prevAcc);
-int fixedArcTangent2(long tanRad1, long tanRad2);
-
-// Prototypes
-static t_NetCallback netCallback(t_NetPacket *packet);
-static volatile t_AppStates appState=IDLE_STATE;
-static volatile int         wahAngle=0;
-
-// If you don't declare some global memory, this whole thing
-// doesn't work!  Don't believe me?  Take this out and see what
-// happens.  Guess how long it took for me to figure that out?
-// I'd love to get in a room with the team who wrote this compiler!
-static char dbgbuf[80];
-static int  bufcnt;
-
-void main(void) 
-{
-  // Wah pedal setting
-  UINT8 wahStep=0;
-  int   topSet =0;
-  int   nToss  =0;
-
-  // Init RF and MCU hardware
-  HAL_RF_init();
-  HAL_MCU_init();
-
-#ifdef MVMT_DEBUG	    
-
-  // if debugging, send data to serial port, in debug
-  // mode the PC is used and not a modem
-  SCITransmitStr("DEBUG: \r\n");
-#endif
-
-  // Delay for a few ms while wah hardware is stabilizing
-  MCU_delay(100);
-  initWahPedal(ARCTANGENT_MIN_ANGLE, ARCTANGENT_MAX_ANGLE);
-
-  // State machine loop.
-  for (;;) {
-    //  
-    // constantly monitor RF data
-    //
-    // if keep alive is received, send ack
-    //
-    // otherwise the RF data is an accelerometer reading
-    //
-    rcvRFData(netCallback);
-    _asm wait;
-
-    switch (appState) {
-    // Transmitter sent a keepalive packet
-    case KEEPALIVE_STATE:
-      // send acknowledgement
-      if (!sendRFMessage(WAH_ACK)) {
-        alarmRFProblem(TRUE);
-      } else {
-        alarmRFProblem(FALSE);
-      }
-      appState=IDLE_STATE;
-      break;
-
-    case WAH_OFF_STATE:
-      wahStep = WAH_POT_POWERONVALUE;
-      setWahPedal(wahStep);
-      runLed(FALSE);
-      appState = IDLE_STATE;
-      break;
-
-    case WAH_ON_STATE:
-      // so that we're in sync with wah hardware when
-      // user turns on with gesture
-      wahStep = WAH_POT_POWERONVALUE;
-      setWahPedal(wahStep);
-      runLed(TRUE);
-      appState = IDLE_STATE;
-      topSet   = 0;
-      wahAngle = 0;
-      nToss    = 0;
-      break;
-
-    case WAH_MOVE_STATE:
-      if (nToss > NUM_TOSS_PACKETS) {
-        // call on first movement after wah is turned on
-        if (!topSet && wahAngle > 0) {
-          // don't set top until we have a sane value
-          setWahTop(wahAngle);
-          topSet = 1;
-        }
-
-        if (wahAngle > 0) {
-          setWahPedalAngle(wahAngle);
-        }
-
-#ifdef MVMT_DEBUG
-        itoa(wahAngle, dbgbuf, 20);  
-        SCITransmitStr(dbgbuf);
-        SCITransmitStr("\r\n");
-#endif
-      } else {
-        nToss++;
-      }
-
-      break;
-    }// switch
-
-  }
-}
-
-static t_NetCallback netCallback(t_NetPacket *packet)
-{
-  long y,z;
-
-#ifdef MVMT_DEBUG
-
-  // if debugging, send data to serial port
-
-  // display all data up to the debug data  
-  SCITransmitArray((char *)packet, sizeof(t_NetPacket) - MAX_NET_DATA);
-
-  // display additional debug data
-  for (bufcnt=0;bufcnt<3;bufcnt++) {
-    itoa(packet->netData[bufcnt], dbgbuf, 20);  
-    SCITransmitStr(dbgbuf);
-    SCITransmitStr(",");
-  }
-  SCITransmitStr("\r\n");
-#endif
-
-  switch (packet->msgType) {
-  case KEEPALIVE:
-    appState = KEEPALIVE_STATE;
-    break;
-
-  case WAH_ON:
-    appState = WAH_ON_STATE;
-    break;
-
-  case WAH_OFF:
-    appState = WAH_OFF_STATE;
-    break;
-
-  case WAH_MVMT:
-    appState = WAH_MOVE_STATE;
-
-    // Calculate angle of wah pedal from accelerometer reading
-    y = (long)packet->netData[1];
-    z = (long)packet->netData[2];
-    wahAngle = fixedArcTangent2(y, z);
-    break;
-
-  default:
-    break;
-  }
-}
-
-
-// Returns atan of parm1/parm2.  Returns angle in
-// fixed point degress to a precision of tenth of degree
-int fixedArcTangent2(long tanRad1, long tanRad2)
-{
-  static long tanRadians;
-  int tanAngle = 0;
-
-  tanRad1 *= ARCTANGENT_PRECISION;
-  //tanRad2 *= ARCTANGENT_PRECISION;
-
-  if (tanRad2>0) {
-    tanRadians = tanRad1/tanRad2;
-    tanRadians -= ARCTANGENT_NORMALIZE;
-    if (tanRadians >= 0 && tanRadians < ARCTANGENT_NUMENTRIES) {
-      tanAngle = fixedArcTangentTable[tanRadians];
-    }
-  }
-
-  return tanAngle;
-}
-
-
-/*********************************************************
- * Turns on/off the RF Problem LED
- *********************************************************/
-void alarmRFProblem(BOOL on_off)
-{
-  LED1 = on_off == TRUE ? LED_ON : LED_OFF;
-}
-
-/*********************************************************
- * Turns on/off the RUN Mode LED
- *********************************************************/
-void runLed(BOOL on_off)
-{
-  LED2 = on_off == TRUE ? LED_ON : LED_OFF;
-}
-
-
-
-
+/****************************************************************************
+* main.c
+* 
+* Author: Bill Bishop - Sixth Sensor
+* Title: 	main.c
+* 
+* This is the main file for the Remote Control Wah Pedal Receiver.
+* The receiver controls the wah pedal hardware based on values 
+* given from transmitter.
+*
+* The RF channel is constantly monitored.  When a keepalive packet is
+* received we send an ack.  When a movement packet is received it is
+* translated into a wah pedal setting.  The translation is just a
+* trig function to calculate the angle of the pedal based on accelerometer
+* values.  Angle packets already carry the angle, the transmitter
+* did the trig.
+*
+****************************************************************************/
+#include <hidef.h> /* for EnableInterrupts macro */
+#include <MC9S08GT60.h> /* include peripheral declarations */
+#include "simple_mac.h"
+#include "mcu_hw_config.h"
+#include "MC13192_hw_config.h"
+#include "SCI.h"
+#include "drivers.h"
+#include "sard_board.h"
+#include "HAL.h"
+#include "net.h"
+#include "statemach.h"
+#include "wahPedal.h"
+#include "fixed_trig.h"
+
+// Number of packets to toss while waiting for
+// accelerometer readings to settle down after the
+// user turns on the device
+#define NUM_TOSS_PACKETS  2
+
+// Absolute range of the pedal angle.  Accelerometer readings are
+// unsigned so the angle always falls in the first quadrant.
+#define WAH_ABS_MIN_ANGLE 0
+#define WAH_ABS_MAX_ANGLE FIXED_ANGLE_90_DEG
+
+void alarmRFProblem(BOOL alarm);
+void runLed(BOOL alarm);
+void runLedFlash();
+int getWahStep(UINT8 wahStep, const t_NetData accReading, const t_NetData prevAcc);
+static void printRFStats(void);
+#ifdef SPI_BENCHMARK
+static void printSPIBenchmark(void);
+#endif
+
+// Events from the RF callback (interrupt) to the main loop go
+// through a single producer, single consumer ring so that a burst
+// of packets doesn't overwrite one not handled yet.  The callback
+// only writes rxEventHead and the main loop only writes 
+// rxEventTail, so no interrupt locking is needed.
+#define RX_EVENT_RING_SIZE        8   // must be a power of 2
+#define RX_EVENT_RING_MASK        (RX_EVENT_RING_SIZE-1)
+
+// Movement events can't use the last few free slots, they are
+// kept for control events (on, off, keepalive) so those are never
+// lost behind a burst of movement.
+#define RX_EVENT_CONTROL_RESERVE  2
+
+typedef struct {
+  t_AppStates state;                // what the main loop should do
+  UINT8       netData[MAX_NET_DATA];// data from the packet
+} t_RxEvent;
+
+// Prototypes
+static t_NetCallback netCallback(t_NetPacket *packet);
+static void putRxEvent(t_AppStates state, t_NetPacket *packet);
+static BOOL getRxEvent(t_RxEvent *event);
+static void printRFEnergy(t_RxEvent *event);
+
+static t_RxEvent            rxEventRing[RX_EVENT_RING_SIZE];
+static volatile UINT8       rxEventHead=0;
+static volatile UINT8       rxEventTail=0;
+static UINT16               rxMoveDrops=0;     // movement, no room
+static UINT16               rxEventOverflows=0;// control, no room
+static int                  wahAngle=FIXED_ATAN2_INVALID;
+
+// Names for the motion frame statistics on the debug port, in
+// NET_STAT_xxx order
+static const char *statNames[MAX_NET_STATS] = 
+{ "rcvd=", " lost=", " gaps=", " dup=", " reord=", " jit=", " jitmax=" };
+
+// If you don't declare some global memory, this whole thing
+// doesn't work!  Don't believe me?  Take this out and see what
+// happens.  Guess how long it took for me to figure that out?
+// I'd love to get in a room with the team who wrote this compiler!
+static char dbgbuf[80];
+static int  bufcnt;
+
+void main(void) 
+{
+  // Wah pedal setting
+  UINT8 wahStep=0;
+  int   topSet =0;
+  int   nToss  =0;
+  static t_RxEvent event;
+
+  // Init RF and MCU hardware
+  HAL_RF_init();
+  HAL_MCU_init();
+
+#ifdef MVMT_DEBUG	    
+
+  // if debugging, send data to serial port, in debug
+  // mode the PC is used and not a modem
+  SCITransmitStr("DEBUG: \r\n");
+#endif
+
+#ifdef SPI_BENCHMARK
+  // TPM1 is borrowed, nothing is using it yet
+  printSPIBenchmark();
+#endif
+
+  // Delay for a few ms while wah hardware is stabilizing
+  MCU_delay(100);
+  initWahPedal(WAH_ABS_MIN_ANGLE, WAH_ABS_MAX_ANGLE);
+
+  // State machine loop.
+  for (;;) {
+    //  
+    // constantly monitor RF data
+    //
+    // if keep alive is received, send ack
+    //
+    // otherwise the RF data is an accelerometer reading
+    //
+    // Receive is re-armed from the interrupt as each packet
+    // arrives, this only turns it on the first time through or
+    // if the 13192 was reset
+    rcvRFDataContinuous(netCallback);
+
+    // Only sleep with nothing queued.  The ring is checked with
+    // interrupts masked, and CLI holds them off one more instruction
+    // so WAIT is reached before a packet that came in meanwhile can 
+    // be handled.  That packet then wakes us instead of sitting in
+    // the ring until the next one.
+    DisableInterrupts;
+    if (rxEventHead == rxEventTail) {
+      EnableInterrupts;
+      MCU_LOW_POWER_WHILE;
+    }
+    EnableInterrupts;
+
+    // handle everything that came in, in order
+    while (getRxEvent(&event)) {
+      switch (event.state) {
+      // Transmitter sent a keepalive packet
+      case KEEPALIVE_STATE:
+        // send acknowledgement
+        if (!sendRFMessage(WAH_ACK)) {
+          alarmRFProblem(TRUE);
+        } else {
+          alarmRFProblem(FALSE);
+        }
+        break;
+
+      case STATS_QUERY_STATE:
+        // answer over the air and dump everything to the debug port
+        if (!sendRFStat(event.netData[0])) {
+          alarmRFProblem(TRUE);
+        } else {
+          alarmRFProblem(FALSE);
+        }
+        printRFStats();
+        break;
+
+      case CHANNEL_STATE:
+        // Ack on the old channel first so the transmitter knows
+        // to follow, then move.  Receive is turned back on on
+        // the new channel at the top of the loop.
+        if (event.netData[0] < PHY_NUM_CHANNELS) {
+          if (!sendRFMessage(WAH_ACK)) {
+            alarmRFProblem(TRUE);
+          } else {
+            alarmRFProblem(FALSE);
+          }
+          stopReceive();
+          changeRFChannel(event.netData[0]);
+        }
+        break;
+
+      case ENERGY_STATE:
+        printRFEnergy(&event);
+        break;
+
+      case WAH_OFF_STATE:
+        wahStep = WAH_POT_POWERONVALUE;
+        setWahPedal(wahStep);
+        runLed(FALSE);
+        printRFStats();
+        break;
+
+      case WAH_ON_STATE:
+        // so that we're in sync with wah hardware when
+        // user turns on with gesture
+        wahStep = WAH_POT_POWERONVALUE;
+        setWahPedal(wahStep);
+        runLed(TRUE);
+        topSet   = 0;
+        wahAngle = FIXED_ATAN2_INVALID;
+        nToss    = 0;
+        break;
+
+      case WAH_MOVE_STATE:
+      case WAH_ANGLE_STATE:
+        if (event.state == WAH_ANGLE_STATE) {
+          // Transmitter already did the math
+          wahAngle = getNetAngle(&event);
+        } else {
+          // Calculate angle of wah pedal from accelerometer reading
+          wahAngle = fixedAtan2((INT16)event.netData[1], (INT16)event.netData[2]);
+        }
+
+        if (nToss > NUM_TOSS_PACKETS) {
+          // call on first movement after wah is turned on
+          if (!topSet && wahAngle != FIXED_ATAN2_INVALID) {
+            // don't set top until we have a sane value
+            setWahTop(wahAngle);
+            topSet = 1;
+          }
+
+          if (wahAngle != FIXED_ATAN2_INVALID) {
+            setWahPedalAngle(wahAngle);
+          }
+
+#ifdef MVMT_DEBUG
+          itoa(wahAngle, dbgbuf, 20);  
+          SCITransmitStr(dbgbuf);
+          SCITransmitStr("\r\n");
+#endif
+        } else {
+          nToss++;
+        }
+
+        break;
+      }// switch
+    }// while events
+
+  }
+}
+
+static t_NetCallback netCallback(t_NetPacket *packet)
+{
+#ifdef MVMT_DEBUG
+
+  // if debugging, send data to serial port
+
+  // display all data up to the debug data  
+  SCITransmitArray((char *)packet, sizeof(t_NetPacket) - MAX_NET_DATA);
+
+  // display additional debug data
+  for (bufcnt=0;bufcnt<3;bufcnt++) {
+    itoa(packet->netData[bufcnt], dbgbuf, 20);  
+    SCITransmitStr(dbgbuf);
+    SCITransmitStr(",");
+  }
+  SCITransmitStr("\r\n");
+#endif
+
+  // Only queue the packet here, all the work is done in the
+  // main loop
+  switch (packet->msgType) {
+  case KEEPALIVE:
+    putRxEvent(KEEPALIVE_STATE, packet);
+    break;
+
+  case WAH_ON:
+    putRxEvent(WAH_ON_STATE, packet);
+    break;
+
+  case WAH_OFF:
+    putRxEvent(WAH_OFF_STATE, packet);
+    break;
+
+  case WAH_MVMT:
+    putRxEvent(WAH_MOVE_STATE, packet);
+    break;
+
+  case WAH_ANGLE:
+    putRxEvent(WAH_ANGLE_STATE, packet);
+    break;
+
+  case WAH_STATS_QUERY:
+    putRxEvent(STATS_QUERY_STATE, packet);
+    break;
+
+  case WAH_CHANNEL:
+    putRxEvent(CHANNEL_STATE, packet);
+    break;
+
+  case WAH_ENERGY:
+    putRxEvent(ENERGY_STATE, packet);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/*********************************************************
+ * Adds an event to the ring.  Called from the RF callback
+ * (interrupt) only.
+ *********************************************************/
+static void putRxEvent(t_AppStates state, t_NetPacket *packet)
+{
+  UINT8 nFree, i;
+  t_RxEvent *event;
+
+  // one slot is always left empty so full != empty
+  nFree = (RX_EVENT_RING_SIZE - 1) - ((rxEventHead - rxEventTail) & RX_EVENT_RING_MASK);
+
+  if (nFree == 0) {
+    rxEventOverflows++;
+    return;
+  }
+
+  if ((state == WAH_MOVE_STATE || state == WAH_ANGLE_STATE) && 
+      nFree <= RX_EVENT_CONTROL_RESERVE) {
+    rxMoveDrops++;
+    return;
+  }
+
+  event = &rxEventRing[rxEventHead];
+  event->state = state;
+  for (i=0; i<MAX_NET_DATA; i++) {
+    event->netData[i] = packet->netData[i];
+  }
+
+  // Publish only after the event is filled in
+  rxEventHead = (rxEventHead + 1) & RX_EVENT_RING_MASK;
+}
+
+/*********************************************************
+ * Takes the oldest event off the ring.  Called from the
+ * main loop only.  Returns FALSE if there are none.
+ *********************************************************/
+static BOOL getRxEvent(t_RxEvent *event)
+{
+  if (rxEventTail == rxEventHead) {
+    return FALSE;
+  }
+
+  *event = rxEventRing[rxEventTail];
+  rxEventTail = (rxEventTail + 1) & RX_EVENT_RING_MASK;
+
+  return TRUE;
+}
+
+/*********************************************************
+ * Sends the motion frame statistics to the SCI port
+ *********************************************************/
+static void printRFStats(void)
+{
+  UINT8 i;
+  t_NetLinkReport link;
+  UINT16 moveDrops, eventOverflows;
+
+  // the receive interrupt counts both, take them together
+  DisableInterrupts;
+  moveDrops = rxMoveDrops;
+  eventOverflows = rxEventOverflows;
+  EnableInterrupts;
+
+  for (i=0; i<MAX_NET_STATS; i++) {
+    SCITransmitStr((char *)statNames[i]);
+    itoa(getRFStat(i), dbgbuf, sizeof(dbgbuf));
+    SCITransmitStr(dbgbuf);
+  }
+
+  // events the main loop never saw
+  SCITransmitStr(" rxdrop=");
+  itoa(moveDrops, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr(" rxovf=");
+  itoa(eventOverflows, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+
+  // the link as the transmitter sees it, from the last keepalive
+  getRFLinkPeer(&link);
+  SCITransmitStr(" txlqi=");
+  itoa(link.lqiMin, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("/");
+  itoa(link.lqiAvg, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("/");
+  itoa(link.lqiMax, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr(" txlost=");
+  itoa(link.linkLost, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("\r\n");
+}
+
+/*********************************************************
+ * Prints one channel of the transmitter's site survey to
+ * the debug port.  The reading is -(ed/2) dBm.
+ *********************************************************/
+static void printRFEnergy(t_RxEvent *event)
+{
+  SCITransmitStr("ch=");
+  itoa(event->netData[NET_ENERGY_CHANNEL], dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr(" ed=");
+  itoa(event->netData[NET_ENERGY_LEVEL], dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  if (event->netData[NET_ENERGY_IN_USE]) {
+    SCITransmitStr(" *");
+  }
+  SCITransmitStr("\r\n");
+}
+
+#ifdef SPI_BENCHMARK
+/****************************************************************************
+ * printSPIBenchmark
+ *
+ * Description: Times the common MC13192 SPI sequences and sends the bus
+ *              cycle counts out the debug port.
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void printSPIBenchmark(void)
+{
+  static spi_benchmark_t bench;
+
+  drv_spi_benchmark(&bench);
+
+  SCITransmitStr("SPI cycles tx=");
+  itoa(bench.tx_packet, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr(" status=");
+  itoa(bench.status_read, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("/");
+  itoa(bench.status_burst, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr(" channel=");
+  itoa(bench.channel_set, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("/");
+  itoa(bench.channel_burst, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr(" switch=");
+  itoa(bench.channel_switch, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("/");
+  itoa(bench.channel_same, dbgbuf, sizeof(dbgbuf));
+  SCITransmitStr(dbgbuf);
+  SCITransmitStr("\r\n");
+}
+#endif
+
+/*********************************************************
+ * Turns on/off the RF Problem LED
+ *********************************************************/
+void alarmRFProblem(BOOL on_off)
+{
+  LED1 = on_off == TRUE ? LED_ON : LED_OFF;
+}
+
+/*********************************************************
+ * Turns on/off the RUN Mode LED
+ *********************************************************/
+void runLed(BOOL on_off)
+{
+  LED2 = on_off == TRUE ? LED_ON : LED_OFF;
+}
+
+
+
+
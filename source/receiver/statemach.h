@@ -1,15 +1,19 @@
-#ifndef _STATEMACH_H
-#define _STATEMACH_H
-
-// State machine states
-typedef enum 
-{ IDLE_STATE,       //
-  KEEPALIVE_STATE,  // received keepalive, send ack
-  WAH_ON_STATE,     // wah is turned on
-  WAH_MOVE_STATE,   // wah is moving
-  WAH_OFF_STATE,    // wah turned off
-  MAX_STATES
-} t_AppStates;
-
-
+#ifndef _STATEMACH_H
+#define _STATEMACH_H
+
+// State machine states
+typedef enum 
+{ IDLE_STATE,       //
+  KEEPALIVE_STATE,  // received keepalive, send ack
+  WAH_ON_STATE,     // wah is turned on
+  WAH_MOVE_STATE,   // wah is moving, accelerometer readings
+  WAH_ANGLE_STATE,  // wah is moving, angle from transmitter
+  WAH_OFF_STATE,    // wah turned off
+  STATS_QUERY_STATE,// motion frame statistics asked for
+  CHANNEL_STATE,    // transmitter is moving us to another channel
+  ENERGY_STATE,     // site survey reading from the transmitter
+  MAX_STATES
+} t_AppStates;
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+// Host simulation stand-in for the CodeWarrior MC9S08GT60.h, only
+// the registers the simulated files touch.
+#include "smac_MC9S08GT60.h"
@@ -0,0 +1,18 @@
+// Host simulation stand-in for the CodeWarrior hidef.h.  There are
+// no real interrupts on the host, the simulation calls the handlers
+// itself between firmware statements (see sim.c), so masking them
+// does nothing.
+#ifndef _SIM_HIDEF_H
+#define _SIM_HIDEF_H
+
+#define EnableInterrupts
+#define DisableInterrupts
+#define interrupt
+
+// MCU_LOW_POWER_WHILE is "_asm wait", on the host waiting for an
+// interrupt runs the virtual clock to the next one
+void simWait(void);
+#define _asm
+#define wait    simWait()
+
+#endif
@@ -0,0 +1,741 @@
+/****************************************************************************
+* sim.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	sim.c
+* 
+* Host simulation of the transmitter.  The real statemach.c, timer.c,
+* accelerometer.c, filter.c, net.c and main.c run on a PC against the
+* stand-ins in this directory: sim_hal.c for HAL.c, sim_smac.c for SMAC 
+* and the MC13192 (with a receiver to talk to), and headers for the 
+* CodeWarrior ones.  It's for trying tuning changes on recorded 
+* accelerometer traces and seeing how much CPU is left, not for timing
+* accurate to the cycle.
+*
+* Build on Linux from the top of the tree, HOST_SIM selects the host 
+* parts of the firmware.  It builds without warnings at -Wall:
+*
+*   gcc -O2 -Wall -DHOST_SIM -DSARD -finstrument-functions \
+*       -finstrument-functions-exclude-file-list=sim/ \
+*       -Isource/sim -Isource/transmitter -Isource/common -Isource/smac4.0 \
+*       -o wahsim source/sim/sim.c source/sim/sim_hal.c source/sim/sim_smac.c \
+*       source/transmitter/main.c source/transmitter/statemach.c \
+*       source/transmitter/timer.c source/transmitter/accelerometer.c \
+*       source/transmitter/filter.c source/common/net.c \
+*       source/common/fixed_trig.c source/common/common_lib.c
+*
+* Run it on a trace (format in sim_hal.c):
+*
+*   wahsim [options] trace
+*
+* sample.trace in this directory rests, moves (idle to ready), presses S1,
+* gives the wah on gesture, rocks the pedal in the run state, then gives
+* the off gesture.
+*
+*   -t seconds    how long to run, default to the end of the trace
+*   -o file       log to file instead of stdout
+*   -q lqi        LQI the receiver hears at POWER_SETTING, default 120
+*   -l percent    random frame loss, default 0
+*   -s seed       seed for the frame loss
+*   -n            no receiver
+*   -e ch,level   energy detect reading for a channel, bigger is quieter
+*   -c cycles     bus cycles per host microsecond, from the board
+*   -p rows       functions in the profile, default 20, 0 for none
+*   -v            log sleeps, channel changes and the ready LED too
+*
+* Time only moves in the stand-ins (sleeps, 13192 timer reads, air time),
+* so the log is the same every run for the same trace and options.  State
+* changes, every frame and the RF alarm LED are logged against it.
+*
+* The profile times each firmware function on the host (gcc 
+* -finstrument-functions).  The share column, where the firmware's time
+* goes, is the useful part.  Host time says nothing about HCS08 bus 
+* cycles: one scale can't fit both the 32 bit math the HCS08 is slow at
+* and the 8 bit code it isn't, so no CPU load is given unless -c brings 
+* a scale measured on the board.  Time in the stand-ins isn't counted,
+* except the quick 13192 timer reads, which stay with the caller (mostly
+* lowPowerHandler).  The awake line is exact: virtual time outside STOP
+* and WAIT.
+*
+****************************************************************************/
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "event.h"
+#include "timer.h"
+#include "sard_board.h"
+
+#define SIM_PROFILE_SLOTS     512     // must be a power of 2
+#define SIM_PROFILE_DEPTH     64
+#define SIM_CALIBRATE_ROUNDS  20
+#define SIM_CALIBRATE_CALLS   1000
+#define SIM_PREEMPTED_NS      50000.0 // no firmware call is this long, the
+                                      // host ran something else
+
+typedef struct {
+  void  *fn;
+  UINT32 calls;
+  double exclNs;      // time in the function itself
+  double maxNs;       // longest call, with what it called
+} t_ProfileSlot;
+
+typedef struct {
+  UINT16 slot;
+  UINT16 children;
+  double start;
+  double childNs;
+} t_ProfileFrame;
+
+// Firmware main, renamed for HOST_SIM (see main.c)
+void txMain(void);
+
+t_simTime simNow=0;
+BOOL      simVerbose=FALSE;
+volatile byte simPortD[8] = {LED_OFF, LED_OFF, LED_OFF, LED_OFF, 
+                             LED_OFF, LED_OFF, LED_OFF, LED_OFF};
+
+static t_simTime simEnd;
+static t_simTime simAsleep=0;          // in STOP or WAIT
+static FILE     *logFile;
+static byte      ledsSeen[2] = {LED_OFF, LED_OFF};
+
+static t_AppStates state=IDLE_STATE;
+static t_simTime   stateSince=0;
+static t_simTime   stateTime[MAX_STATES];
+static UINT32      stateEntries[MAX_STATES];
+
+static BOOL   profiling=FALSE;
+static t_ProfileSlot  profile[SIM_PROFILE_SLOTS];
+static t_ProfileFrame profileStack[SIM_PROFILE_DEPTH];
+static int    profileDepth=0;
+static UINT32 profileLost=0;           // calls too deep to count
+static UINT32 profilePreempted=0;      // calls the host got in the middle of
+static int    pauseDepth=0;
+static double pauseStart, pausedNs=0;
+static double hookNs=0;                // a pair of hooks, called
+static double emptyNs=0;               // what they leave in an empty function
+static double pauseNs=0;               // what a pause leaves in the caller
+static double cyclesPerNs=0;           // -c, 0 for host ns
+static int    profileRows=20;
+static struct timespec hostStart;
+
+static const char *stateNames[] = {"idle", "ready", "run"};
+static const char *eventNames[] = {
+  "NIL_EVENT", "SYSTEM_INIT", "MVMT_SAMPLE_READY", "TIMER_EXPIRED", 
+  "MVMT_OCCURED", "ACK_RECEIVED", "ACK_TIMEOUT", "KB_PRESS", "KB_EVENT",
+  "IDLE_LOOP_WAIT"
+};
+static const char *timerNames[] = {
+  "ACK_WAIT_TIMER", "KEEPALIVE_SEND_TIMER", "IDLE_TIMER", "KB_DEBOUNCE_TIMER",
+  "KB_POLL_TIMER", "READY_FLASH_TIMER", "GESTURE_DEBOUNCE_TIMER"
+};
+
+// The build fails here if the names are out of step
+typedef char simStateNamesCheck[(sizeof(stateNames)/sizeof(stateNames[0]) == MAX_STATES) ? 1 : -1];
+typedef char simEventNamesCheck[(sizeof(eventNames)/sizeof(eventNames[0]) == MAX_EVENTS) ? 1 : -1];
+typedef char simTimerNamesCheck[(sizeof(timerNames)/sizeof(timerNames[0]) == MAX_TIMERS) ? 1 : -1];
+
+static void usage(void);
+static void finish(void);
+static void watchLeds(void);
+static void calibrate(void);
+static t_ProfileSlot *calibrateSlot(void);
+static void profileReport(FILE *out, double simSeconds);
+static const char *symbolName(void *fn, char *buf, int buflen);
+void __cyg_profile_func_enter(void *fn, void *site) __attribute__((no_instrument_function));
+void __cyg_profile_func_exit(void *fn, void *site) __attribute__((no_instrument_function));
+static double hostNs(void) __attribute__((no_instrument_function));
+
+/****************************************************************************
+ * main
+ *
+ * Description: Reads the options and the trace, then runs the firmware
+ *              until the virtual clock gets to the end
+ *
+ * Parms:       see the top of this file
+ *
+ * Returns:     0, or 1 for bad options
+ ***************************************************************************/
+int main(int argc, char *argv[])
+{
+  int    opt, ch, level;
+  double seconds=-1, cyclesPerUs=0;
+  int    lqi=SIM_RX_LQI_DEFAULT, loss=0;
+  UINT32 seed=1;
+  BOOL   answer=TRUE;
+
+  logFile = stdout;
+
+  while ((opt = getopt(argc, argv, "t:o:q:l:s:ne:c:p:v")) != -1) {
+    switch (opt) {
+    case 't':
+      seconds = atof(optarg);
+      break;
+    case 'o':
+      logFile = fopen(optarg, "w");
+      if (logFile == NULL) {
+        perror(optarg);
+        return 1;
+      }
+      break;
+    case 'q':
+      lqi = atoi(optarg);
+      break;
+    case 'l':
+      loss = atoi(optarg);
+      break;
+    case 's':
+      seed = (UINT32)strtoul(optarg, NULL, 0);
+      break;
+    case 'n':
+      answer = FALSE;
+      break;
+    case 'e':
+      if (sscanf(optarg, "%d,%d", &ch, &level) != 2) {
+        usage();
+        return 1;
+      }
+      simRadioSetEnergy((UINT8)ch, (UINT8)level);
+      break;
+    case 'c':
+      cyclesPerUs = atof(optarg);
+      break;
+    case 'p':
+      profileRows = atoi(optarg);
+      break;
+    case 'v':
+      simVerbose = TRUE;
+      break;
+    default:
+      usage();
+      return 1;
+    }
+  }
+
+  if (optind != argc - 1 || lqi < 0 || lqi > 0xFF || loss < 0 || loss > 100) {
+    usage();
+    return 1;
+  }
+
+  if (!simTraceLoad(argv[optind])) {
+    return 1;
+  }
+  simEnd = (seconds >= 0) ? (t_simTime)(seconds * 1000 * SIM_TICKS_PER_MS) : simTraceEnd();
+  simRadioSetup((UINT8)lqi, (UINT8)loss, answer, seed);
+
+  calibrate();
+  cyclesPerNs = cyclesPerUs / 1000;
+
+  clock_gettime(CLOCK_MONOTONIC, &hostStart);
+  simLog("start trace %s, %.3f s", argv[optind], (double)simEnd / (SIM_TICKS_PER_MS * 1000.0));
+  profiling = (profileRows > 0);
+
+  // never comes back, finish() exits at simEnd
+  txMain();
+  return 0;
+}
+
+/****************************************************************************
+ * usage
+ ***************************************************************************/
+static void usage(void)
+{
+  fprintf(stderr, "usage: wahsim [-t seconds] [-o log] [-q lqi] [-l loss%%] [-s seed] [-n]\n"
+                  "              [-e ch,level]... [-c cycles/us] [-p rows] [-v] trace\n");
+}
+
+/****************************************************************************
+ * simRunUntil
+ *
+ * Description: Runs the virtual clock, firing the keyboard and radio 
+ *              interrupts that come due on the way.  Ends the 
+ *              simulation if the clock gets to the end.
+ *
+ * Parms:       until - virtual time to stop at
+ *              wake  - TRUE to stop at the first interrupt instead, like
+ *                      STOP or WAIT
+ *
+ * Returns:     TRUE if an interrupt fired
+ ***************************************************************************/
+BOOL simRunUntil(t_simTime until, BOOL wake)
+{
+  t_simTime kb, radio, next;
+  BOOL fired=FALSE;
+
+  kb = simKbNext();
+  radio = simRadioNext();
+  if (until < kb && until < radio && until < simEnd) {
+    // Nothing happens on the way, the usual case for the short busy
+    // waits.  Not pausing the profile leaves a little host time on 
+    // the caller, but pausing leaves more.
+    if (until > simNow) {
+      if (wake) {
+        simAsleep += until - simNow;
+      }
+      simNow = until;
+    }
+    return FALSE;
+  }
+
+  simProfileStop();
+
+  for (;;) {
+    next = getMin(until, getMin(kb, radio));
+    if (next > simNow) {
+      if (wake) {
+        simAsleep += next - simNow;
+      }
+      simNow = next;
+    }
+    if (simNow >= simEnd) {
+      finish();
+    }
+    watchLeds();
+
+    if (kb <= simNow) {
+      simKbFire();
+    } else if (radio <= simNow) {
+      simRadioFire();
+    } else {
+      break;
+    }
+
+    fired = TRUE;
+    if (wake) {
+      break;
+    }
+    kb = simKbNext();
+    radio = simRadioNext();
+  }
+
+  simProfileStart();
+  return fired;
+}
+
+/****************************************************************************
+ * simWait
+ *
+ * Description: The WAIT instruction, runs to the next interrupt
+ ***************************************************************************/
+void simWait(void)
+{
+  simRunUntil(simNow + SIM_WAIT_LIMIT, TRUE);
+}
+
+/****************************************************************************
+ * simLog
+ *
+ * Description: printf to the log with the virtual time in ms
+ ***************************************************************************/
+void simLog(const char *format, ...)
+{
+  va_list args;
+
+  simProfileStop();
+  fprintf(logFile, "%11.3f  ", (double)simNow / SIM_TICKS_PER_MS);
+  va_start(args, format);
+  vfprintf(logFile, format, args);
+  va_end(args);
+  fputc('\n', logFile);
+  simProfileStart();
+}
+
+/****************************************************************************
+ * simStateChange
+ *
+ * Description: Called by stMachDispatch for every state change
+ *
+ * Parms:       from, to - states
+ *              trigger  - event, or MAX_EVENTS + timer id for a timer
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simStateChange(t_AppStates from, t_AppStates to, UINT8 trigger)
+{
+  const char *why;
+
+  if (trigger < MAX_EVENTS) {
+    why = eventNames[trigger];
+  } else if (trigger - MAX_EVENTS < MAX_TIMERS) {
+    why = timerNames[trigger - MAX_EVENTS];
+  } else {
+    why = "?";
+  }
+
+  simLog("state %s -> %s on %s", stateNames[from], stateNames[to], why);
+
+  stateTime[state] += simNow - stateSince;
+  stateSince = simNow;
+  state = to;
+  stateEntries[to]++;
+}
+
+/****************************************************************************
+ * watchLeds
+ *
+ * Description: Logs the LEDs changing, the RF alarm always and the 
+ *              run/ready LED with -v
+ ***************************************************************************/
+static void watchLeds(void)
+{
+  if (LED1 != ledsSeen[0]) {
+    ledsSeen[0] = LED1;
+    simLog("led  rf alarm %s", LED1 == LED_ON ? "on" : "off");
+  }
+  if (LED2 != ledsSeen[1]) {
+    ledsSeen[1] = LED2;
+    if (simVerbose) {
+      simLog("led  run %s", LED2 == LED_ON ? "on" : "off");
+    }
+  }
+}
+
+/****************************************************************************
+ * finish
+ *
+ * Description: End of the run, prints the summary and exits
+ ***************************************************************************/
+static void finish(void)
+{
+  struct timespec hostEnd;
+  double simSeconds = (double)simNow / (SIM_TICKS_PER_MS * 1000.0);
+  t_SleepStats sleep;
+  UINT16 drops;
+  UINT8  maxDepth;
+  int    i;
+
+  profiling = FALSE;
+  clock_gettime(CLOCK_MONOTONIC, &hostEnd);
+  simLog("end");
+
+  stateTime[state] += simNow - stateSince;
+  stateSince = simNow;
+
+  fprintf(logFile, "\n%.3f s simulated in %.3f s\n", simSeconds,
+          (hostEnd.tv_sec - hostStart.tv_sec) + (hostEnd.tv_nsec - hostStart.tv_nsec) / 1e9);
+
+  for (i=0; i<MAX_STATES; i++) {
+    getSleepStats((t_AppStates)i, &sleep);
+    fprintf(logFile, "%-5s %10.3f s, entered %lu, sleeps %u, fine %u for %lu ticks, early %u, spun %lu ticks\n",
+            stateNames[i], (double)stateTime[i] / (SIM_TICKS_PER_MS * 1000.0), 
+            stateEntries[i], sleep.sleeps, sleep.fineSleeps, sleep.fineTicks,
+            sleep.earlyWakes, sleep.spinTicks);
+  }
+
+  fprintf(logFile, "awake %.2f%% of the time, busy waits and air time, not counting the code\n",
+          simNow ? 100.0 * (simNow - simAsleep) / simNow : 0.0);
+
+  getEventStats(&drops, &maxDepth);
+  fprintf(logFile, "events %u dropped, queue depth %u of %u\n", 
+          drops, maxDepth, EVENT_QUEUE_SIZE);
+
+  simRadioReport(logFile);
+  simHalReport(logFile);
+
+  if (profileRows > 0) {
+    profileReport(logFile, simSeconds);
+  }
+
+  fflush(logFile);
+  exit(0);
+}
+
+/****************************************************************************
+ * PROFILER
+ *
+ * gcc calls the hooks on the way in and out of every function built with
+ * -finstrument-functions.  Each function gets the host time spent in it, 
+ * less what it called and the hooks themselves.  simProfileStop and 
+ * simProfileStart leave the time in the stand-ins out, they nest.
+ ***************************************************************************/
+static double hostNs(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec - pausedNs;
+}
+
+void simProfileStop(void)
+{
+  if (pauseDepth++ == 0) {
+    pauseStart = hostNs();
+  }
+}
+
+void simProfileStart(void)
+{
+  if (--pauseDepth == 0) {
+    pausedNs += hostNs() - pauseStart + pauseNs;
+  }
+}
+
+void __cyg_profile_func_enter(void *fn, void *site)
+{
+  UINT16 slot;
+  t_ProfileFrame *frame;
+
+  (void)site;
+  if (!profiling) {
+    return;
+  }
+
+  if (profileDepth >= SIM_PROFILE_DEPTH) {
+    profileDepth++;
+    profileLost++;
+    return;
+  }
+
+  slot = (UINT16)(((size_t)fn >> 2) & (SIM_PROFILE_SLOTS - 1));
+  while (profile[slot].fn != fn && profile[slot].fn != NULL) {
+    slot = (slot + 1) & (SIM_PROFILE_SLOTS - 1);
+  }
+  profile[slot].fn = fn;
+
+  frame = &profileStack[profileDepth++];
+  frame->slot = slot;
+  frame->children = 0;
+  frame->childNs = 0;
+  frame->start = hostNs();
+}
+
+void __cyg_profile_func_exit(void *fn, void *site)
+{
+  double now, took, self;
+  t_ProfileFrame *frame;
+  t_ProfileSlot  *slot;
+
+  (void)fn;
+  (void)site;
+  now = hostNs();
+  if (!profiling || profileDepth == 0) {
+    return;
+  }
+  if (profileDepth > SIM_PROFILE_DEPTH) {
+    profileDepth--;
+    return;
+  }
+
+  frame = &profileStack[--profileDepth];
+  slot = &profile[frame->slot];
+  took = now - frame->start;
+  self = took - emptyNs - frame->childNs - frame->children * (hookNs - emptyNs);
+
+  slot->calls++;
+  if (self > SIM_PREEMPTED_NS) {
+    // the caller gets it taken off too
+    profilePreempted++;
+  } else {
+    slot->exclNs += (self > 0) ? self : 0;
+    if (took > slot->maxNs) {
+      slot->maxNs = took;
+    }
+  }
+
+  if (profileDepth > 0) {
+    profileStack[profileDepth-1].childNs += took;
+    profileStack[profileDepth-1].children++;
+  }
+}
+
+/****************************************************************************
+ * calibrate
+ *
+ * Description: Times the profile hooks on this host
+ ***************************************************************************/
+static void calibrate(void)
+{
+  double start, took, bestEmpty=1e9, bestPause=1e9;
+  int    round, i;
+
+  // Best of a few rounds, anything slower had the host doing 
+  // something else
+  hookNs = 1e9;
+
+  for (round=0; round<SIM_CALIBRATE_ROUNDS; round++) {
+    profiling = TRUE;
+    emptyNs = pauseNs = 0;
+
+    // a hook pair on its own, the profile has what an empty function
+    // would show
+    memset(profile, 0, sizeof(profile));
+    start = hostNs();
+    for (i=0; i<SIM_CALIBRATE_CALLS; i++) {
+      __cyg_profile_func_enter((void *)&calibrate, NULL);
+      __cyg_profile_func_exit((void *)&calibrate, NULL);
+    }
+    took = (hostNs() - start) / SIM_CALIBRATE_CALLS;
+    hookNs = getMin(hookNs, took);
+    took = calibrateSlot()->exclNs / SIM_CALIBRATE_CALLS;
+    bestEmpty = getMin(bestEmpty, took);
+
+    // and what a pause leaves behind on top of that
+    memset(profile, 0, sizeof(profile));
+    emptyNs = took;
+    for (i=0; i<SIM_CALIBRATE_CALLS; i++) {
+      __cyg_profile_func_enter((void *)&calibrate, NULL);
+      simProfileStop();
+      simProfileStart();
+      __cyg_profile_func_exit((void *)&calibrate, NULL);
+    }
+    took = calibrateSlot()->exclNs / SIM_CALIBRATE_CALLS;
+    bestPause = getMin(bestPause, took);
+
+    profiling = FALSE;
+  }
+
+  emptyNs = bestEmpty;
+  pauseNs = bestPause;
+  memset(profile, 0, sizeof(profile));
+  profileDepth = 0;
+}
+
+/****************************************************************************
+ * calibrateSlot
+ *
+ * Description: The profile of calibrate(), standing in for an empty 
+ *              function
+ ***************************************************************************/
+static t_ProfileSlot *calibrateSlot(void)
+{
+  UINT16 slot;
+
+  for (slot=0; slot<SIM_PROFILE_SLOTS; slot++) {
+    if (profile[slot].fn == (void *)&calibrate) {
+      return &profile[slot];
+    }
+  }
+  return &profile[0];
+}
+
+/****************************************************************************
+ * profileReport
+ *
+ * Description: Where the firmware's time went, busiest function first.
+ *              In bus cycles and as a load on the bus clock with -c,
+ *              otherwise in ns on this host.
+ ***************************************************************************/
+static void profileReport(FILE *out, double simSeconds)
+{
+  static t_ProfileSlot sorted[SIM_PROFILE_SLOTS];
+  t_ProfileSlot tmp;
+  int    used=0, i, j;
+  double totalNs=0, scale;
+  char   name[64];
+
+  for (i=0; i<SIM_PROFILE_SLOTS; i++) {
+    if (profile[i].calls > 0) {
+      sorted[used++] = profile[i];
+      totalNs += profile[i].exclNs;
+    }
+  }
+
+  // busiest first
+  for (i=1; i<used; i++) {
+    tmp = sorted[i];
+    for (j=i; j>0 && sorted[j-1].exclNs < tmp.exclNs; j--) {
+      sorted[j] = sorted[j-1];
+    }
+    sorted[j] = tmp;
+  }
+
+  if (cyclesPerNs > 0) {
+    scale = cyclesPerNs;
+    fprintf(out, "\ncpu  ~%.0f bus cycles, %.2f%% of %.1fMHz at %.0f cycles/us\n", 
+            totalNs * scale, 
+            simSeconds > 0 ? 100.0 * totalNs * scale / (simSeconds * SIM_BUS_HZ) : 0.0,
+            SIM_BUS_HZ / 1e6, cyclesPerNs * 1000);
+  } else {
+    scale = 1;
+    fprintf(out, "\ncpu  %.3f ms on this host, -c for bus cycles\n", totalNs / 1e6);
+  }
+  if (profileLost != 0 || profilePreempted != 0) {
+    fprintf(out, "cpu  %lu calls too deep to count, %lu cut into by the host\n", 
+            profileLost, profilePreempted);
+  }
+  fprintf(out, "%-28s %10s %6s %12s %9s %9s\n", "function", "calls", "share", 
+          cyclesPerNs > 0 ? "cycles" : "host ns", "avg", "max");
+
+  for (i=0; i<used && i<profileRows; i++) {
+    fprintf(out, "%-28s %10lu %5.1f%% %12.0f %9.0f %9.0f\n", 
+            symbolName(sorted[i].fn, name, sizeof(name)), sorted[i].calls,
+            totalNs > 0 ? 100.0 * sorted[i].exclNs / totalNs : 0.0,
+            sorted[i].exclNs * scale, 
+            sorted[i].exclNs * scale / sorted[i].calls,
+            sorted[i].maxNs * scale);
+  }
+}
+
+/****************************************************************************
+ * symbolName
+ *
+ * Description: Function name for an address, from nm on this program.
+ *              Static functions aren't in the dynamic symbols, so dladdr
+ *              won't do.  The address is printed if nm can't be run.
+ *
+ * Parms:       fn     - function address
+ *              buf    - for the name
+ *              buflen - size of buf
+ *
+ * Returns:     buf
+ ***************************************************************************/
+static const char *symbolName(void *fn, char *buf, int buflen)
+{
+  static BOOL  loaded=FALSE;
+  static char  (*names)[48] = NULL;
+  static size_t *addrs = NULL;
+  static int   count=0;
+  static long  bias=0;
+  char   exe[256], cmd[300], line[256], name[200], type;
+  unsigned long addr;
+  FILE  *nm;
+  int    i, size=0;
+  ssize_t len;
+
+  if (!loaded) {
+    loaded = TRUE;
+    len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (len > 0) {
+      exe[len] = '\0';
+      sprintf(cmd, "nm --defined-only '%s' 2>/dev/null", exe);
+      nm = popen(cmd, "r");
+      while (nm != NULL && fgets(line, sizeof(line), nm) != NULL) {
+        if (sscanf(line, "%lx %c %199s", &addr, &type, name) != 3 ||
+            (type != 't' && type != 'T')) {
+          continue;
+        }
+        if (count == size) {
+          size = size ? size * 2 : 512;
+          names = realloc(names, size * sizeof(*names));
+          addrs = realloc(addrs, size * sizeof(*addrs));
+        }
+        // names too long for the slot are cut short
+        i = (int)getMin(strlen(name), sizeof(names[count]) - 1);
+        memcpy(names[count], name, i);
+        names[count][i] = '\0';
+        addrs[count] = addr;
+        if (strcmp(name, "main") == 0) {
+          bias = (long)((size_t)&main - addr);
+        }
+        count++;
+      }
+      if (nm != NULL) {
+        pclose(nm);
+      }
+    }
+  }
+
+  for (i=0; i<count; i++) {
+    if (addrs[i] + bias == (size_t)fn) {
+      strncpy(buf, names[i], buflen - 1);
+      buf[buflen - 1] = '\0';
+      return buf;
+    }
+  }
+
+  sprintf(buf, "%p", fn);
+  return buf;
+}
@@ -0,0 +1,66 @@
+#ifndef _SIM_H
+#define _SIM_H
+
+// Host simulation of the transmitter, see sim.c for how to build
+// and run it.
+
+#include <stdio.h>
+#include "common_def.h"
+#include "HAL.h"
+#include "net.h"
+#include "statemach.h"
+
+// ******************************************
+// SIMULATION SETTINGS
+// ******************************************
+// Virtual clock, MC13192 ticks (4us, see HAL.h) since power up.
+// It doesn't wrap like the 24 bit 13192 time does.
+typedef unsigned long t_simTime;
+
+#define SIM_TICKS_PER_MS      250
+
+// What the stand-ins cost in virtual time.  Nothing else moves the
+// clock, so the firmware runs the same way every time on the same
+// trace, however fast the host is.
+#define SIM_GET_TICKS_COST    2     // SPI read of the 13192 timer
+#define SIM_RF_WAKE_TICKS     81    // ~323us, HAL_RF_wake_wait
+#define SIM_TX_BYTE_TICKS     8     // 32us a byte on the air
+#define SIM_TX_OVERHEAD       12    // preamble, SFD, length, FCS
+#define SIM_ACK_TURNAROUND    250   // receiver answers in ~1ms
+#define SIM_ENERGY_TICKS      32    // one energy detect, 128us
+#define SIM_WAIT_LIMIT        (1000L * SIM_TICKS_PER_MS)
+
+// Bus clock for the CPU load with -c.  16MHz from the 13192 CLKO
+// halved, baud38400 in HAL.h assumes the same.
+#define SIM_BUS_HZ            8000000L
+// ******************************************
+// END SIMULATION SETTINGS
+// ******************************************
+
+extern t_simTime simNow;
+extern BOOL      simVerbose;
+
+// sim.c
+BOOL simRunUntil(t_simTime until, BOOL wake);
+void simLog(const char *format, ...);
+void simProfileStop(void);
+void simProfileStart(void);
+void simStateChange(t_AppStates from, t_AppStates to, UINT8 trigger);
+
+// sim_hal.c, accelerometer trace and keyboard
+BOOL simTraceLoad(const char *fileName);
+t_simTime simTraceEnd(void);
+t_simTime simKbNext(void);
+void simKbFire(void);
+void simHalReport(FILE *out);
+
+// sim_smac.c, the radio and a receiver to talk to
+#define SIM_RX_LQI_DEFAULT    120
+void simRadioSetup(UINT8 lqi, UINT8 loss, BOOL answers, UINT32 seed);
+void simRadioSetEnergy(UINT8 channel, UINT8 level);
+void simRadioDoze(BOOL doze);
+t_simTime simRadioNext(void);
+void simRadioFire(void);
+void simRadioReport(FILE *out);
+
+#endif
@@ -0,0 +1,294 @@
+/****************************************************************************
+* sim_hal.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	sim_hal.c
+* 
+* Host simulation stand-in for HAL.c.  Time is the virtual clock in sim.c,
+* a sleep runs it to the RTI wakeup (or an earlier interrupt), and the
+* accelerometers read from a trace file.
+*
+* Trace file, one line per change, anything after # is a comment:
+*
+*   time_ms  x  y  z  [keys]
+*
+* x, y, z are the 8 bit ATD readings in ACC_AXIS order, held until the
+* next line.  keys is optional, bit 0 is S1 and bit 1 is S2, a key is 
+* pressed when its bit goes from 0 to 1.  Times must not go backwards.
+*
+****************************************************************************/
+#include <stdlib.h>
+#include "sim.h"
+#include "accelerometer.h"
+
+typedef struct {
+  t_simTime time;
+  UINT8     value[HAL_ADC_MAX_CHANNELS];
+  UINT8     keys;
+} t_TraceLine;
+
+#define SIM_KEY_S1    0x01
+#define SIM_KEY_S2    0x02
+
+static t_TraceLine *trace=NULL;
+static UINT16 traceLines=0;
+static UINT16 traceIdx=0;       // line in effect now
+static UINT16 keyIdx=1;         // next line to look for a key press in
+
+static UINT8  adcChannels=0;
+static UINT32 adcScans=0;
+
+static BOOL   s1Pressed=FALSE;
+static BOOL   s2Pressed=FALSE;
+
+// RTI lengths in 13192 ticks, see sleepSteps in statemach.c
+static const t_simTime rtiTicks[8]     = {0, 1024, 4096, 8192, 16384, 32768, 65536, 131072};
+static const t_simTime rtiFineTicks[8] = {0, 64, 256, 512, 1024, 2048, 4096, 8192};
+
+/****************************************************************************
+ * simTraceLoad
+ *
+ * Description: Reads the accelerometer trace
+ *
+ * Parms:       fileName - trace file
+ *
+ * Returns:     FALSE if it couldn't be read
+ ***************************************************************************/
+BOOL simTraceLoad(const char *fileName)
+{
+  FILE *in;
+  char  line[128], *hash;
+  double ms;
+  int   x, y, z, keys, fields;
+  UINT16 size=0, lineNum=0;
+
+  in = fopen(fileName, "r");
+  if (in == NULL) {
+    perror(fileName);
+    return FALSE;
+  }
+
+  while (fgets(line, sizeof(line), in) != NULL) {
+    lineNum++;
+    hash = strchr(line, '#');
+    if (hash != NULL) {
+      *hash = '\0';
+    }
+
+    keys = 0;
+    fields = sscanf(line, "%lf %d %d %d %d", &ms, &x, &y, &z, &keys);
+    if (fields <= 0) {
+      continue;
+    }
+    if (fields < 4 || ms < 0 ||
+        (traceLines > 0 && ms * SIM_TICKS_PER_MS < trace[traceLines-1].time)) {
+      fprintf(stderr, "%s:%u: bad trace line\n", fileName, lineNum);
+      fclose(in);
+      return FALSE;
+    }
+
+    if (traceLines == size) {
+      size = size ? size * 2 : 256;
+      trace = realloc(trace, size * sizeof(t_TraceLine));
+      if (trace == NULL) {
+        fprintf(stderr, "%s: out of memory\n", fileName);
+        fclose(in);
+        return FALSE;
+      }
+    }
+
+    trace[traceLines].time = (t_simTime)(ms * SIM_TICKS_PER_MS);
+    trace[traceLines].value[ACC_AXIS_X] = (UINT8)x;
+    trace[traceLines].value[ACC_AXIS_Y] = (UINT8)y;
+    trace[traceLines].value[ACC_AXIS_Z] = (UINT8)z;
+    trace[traceLines].keys = (UINT8)keys;
+    traceLines++;
+  }
+  fclose(in);
+
+  if (traceLines == 0) {
+    fprintf(stderr, "%s: no samples\n", fileName);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/****************************************************************************
+ * simTraceEnd
+ *
+ * Description: Time of the last trace line
+ *
+ * Parms:       none
+ *
+ * Returns:     virtual time
+ ***************************************************************************/
+t_simTime simTraceEnd(void)
+{
+  return trace[traceLines-1].time;
+}
+
+/****************************************************************************
+ * simKbNext
+ *
+ * Description: When the next key press is in the trace
+ *
+ * Parms:       none
+ *
+ * Returns:     virtual time, or ~0 if there are no more
+ ***************************************************************************/
+t_simTime simKbNext(void)
+{
+  for (; keyIdx<traceLines; keyIdx++) {
+    if (trace[keyIdx].keys & ~trace[keyIdx-1].keys) {
+      return trace[keyIdx].time;
+    }
+  }
+  return ~(t_simTime)0;
+}
+
+/****************************************************************************
+ * simKbFire
+ *
+ * Description: The keyboard interrupt for the press simKbNext found
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simKbFire(void)
+{
+  UINT8 pressed = trace[keyIdx].keys & ~trace[keyIdx-1].keys;
+
+  if (pressed & SIM_KEY_S1) {
+    s1Pressed = TRUE;
+    simLog("key  S1");
+  }
+  if (pressed & SIM_KEY_S2) {
+    s2Pressed = TRUE;
+    simLog("key  S2");
+  }
+  keyIdx++;
+}
+
+/****************************************************************************
+ * simHalReport
+ *
+ * Description: End of run numbers
+ *
+ * Parms:       out - where to print them
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simHalReport(FILE *out)
+{
+  fprintf(out, "adc  %lu scans of %u channels, trace line %u of %u\n", 
+          adcScans, adcChannels, traceIdx + 1, traceLines);
+}
+
+/****************************************************************************
+ * HAL procedures, see HAL.c
+ ***************************************************************************/
+void HAL_getTicks(t_time *time)
+{
+  simRunUntil(simNow + SIM_GET_TICKS_COST, FALSE);
+  *time = simNow & MAX_TIME_VALUE;
+}
+
+void HAL_MCU_init(void)
+{
+  // Make sure channel and power levels are initialized  
+  setRFChannel();
+}
+
+void HAL_RF_init(void)
+{
+  setRFChannel();
+  simRadioDoze(FALSE);
+}
+
+void HAL_RF_lowpower(void)
+{
+  simRadioDoze(TRUE);
+}
+
+void HAL_RF_wake_wait(void)
+{
+  simRadioDoze(FALSE);
+  simRunUntil(simNow + SIM_RF_WAKE_TICKS, FALSE);
+}
+
+void HAL_MCU_wake(void)
+{
+}
+
+void HAL_MCU_sleep(UINT8 time_val, int deep)
+{
+  (void)deep;
+  if (simVerbose) {
+    simLog("stop %lu ticks", rtiTicks[time_val & 0x07]);
+  }
+  simRunUntil(simNow + rtiTicks[time_val & 0x07], TRUE);
+}
+
+void HAL_MCU_sleepFine(UINT8 time_val)
+{
+  if (simVerbose) {
+    simLog("stop %lu ticks, fine", rtiFineTicks[time_val & 0x07]);
+  }
+  simRunUntil(simNow + rtiFineTicks[time_val & 0x07], TRUE);
+}
+
+void MCU_delay(UINT16 delayMS)
+{
+  simRunUntil(simNow + (t_simTime)delayMS * SIM_TICKS_PER_MS, FALSE);
+}
+
+BOOL HAL_KB_poll_s1(void)
+{
+  return s1Pressed;
+}
+
+BOOL HAL_KB_poll_s2(void)
+{
+  return s2Pressed;
+}
+
+void HAL_KB_clear(void)
+{
+  s1Pressed = FALSE;
+  s2Pressed = FALSE;
+}
+
+void HAL_ADC_init(UINT8 pinEnable, UINT8 control, const UINT8 *channels, UINT8 numChannels)
+{
+  (void)pinEnable;
+  (void)control;
+  (void)channels;
+  adcChannels = numChannels;
+}
+
+BOOL HAL_ADC_startScan(void)
+{
+  return TRUE;
+}
+
+BOOL HAL_ADC_getScan(t_AdcScan *scan)
+{
+  UINT8 i;
+
+  while (traceIdx + 1 < traceLines && trace[traceIdx+1].time <= simNow) {
+    traceIdx++;
+  }
+
+  for (i=0; i<adcChannels && i<HAL_ADC_MAX_CHANNELS; i++) {
+    scan->value[i] = trace[traceIdx].value[i];
+  }
+  adcScans++;
+  return TRUE;
+}
+
+void HAL_ADC_getStats(UINT16 *timeouts, UINT16 *overruns)
+{
+  *timeouts = 0;
+  *overruns = 0;
+}
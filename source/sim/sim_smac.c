@@ -0,0 +1,557 @@
+/****************************************************************************
+* sim_smac.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	sim_smac.c
+* 
+* Host simulation stand-in for SMAC and the MC13192, with a receiver at
+* the other end.  Frames take their air time on the virtual clock and 
+* are logged.  The receiver answers KEEPALIVE and WAH_CHANNEL with a 
+* WAH_ACK carrying its link report, the way receiver/main.c does, and
+* follows WAH_CHANNEL.
+*
+* The link is simple: the receiver hears the transmitter at the LQI given
+* on the command line, 3 better or worse for each PA step from 
+* POWER_SETTING, and nothing below SIM_RX_LQI_MIN.  On top of that frames
+* both ways are lost at random at the given rate.  The ack comes back at
+* the command line LQI.
+*
+****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "simple_mac.h"
+
+// net.c, SMAC calls it without a prototype
+void MCPS_data_indication(rx_packet_t *rx_packet);
+
+// Receiver loses packets around lqi 70 (see net.h)
+#define SIM_RX_LQI_MIN        70
+#define SIM_LQI_PER_STEP      3
+
+// Energy detect reading for channels not set with -e, quiet
+#define SIM_ENERGY_DEFAULT    0xB0
+
+static const char *msgNames[] = {
+  "KEEPALIVE", "WAH_ON", "WAH_OFF", "WAH_MVMT", "WAH_ACK", "WAH_ANGLE", 
+  "WAH_STATS_QUERY", "WAH_STATS", "WAH_CHANNEL", "WAH_ENERGY"
+};
+#define NUM_MSG_NAMES   (sizeof(msgNames)/sizeof(msgNames[0]))
+
+// The 13192 of the transmitter
+static UINT8  channel=0;
+static UINT8  power=POWER_SETTING;
+static BOOL   dozing=TRUE;
+static rx_packet_t *rxPacket=NULL;     // receive on when not NULL
+static t_simTime rxTimeout;            // 0 to wait forever
+static t_simTime txDone=0;             // asynchronous send finishes, 0 if none
+static UINT8  energy[PHY_NUM_CHANNELS];
+static BOOL   energySet=FALSE;
+
+// The receiver
+static UINT8  rxLqi=SIM_RX_LQI_DEFAULT;
+static UINT8  lossPercent=0;
+static BOOL   answer=TRUE;
+static UINT8  peerChannel=NET_DEFAULT_CHANNEL;
+static UINT32 lossSeed=1;
+static t_NetPacket ack;
+static t_simTime ackTime=0;            // ack to deliver, 0 if none
+static UINT8  ackChannel;              // channel the ack goes out on
+static int    peerMoveTo=-1;           // channel after the ack
+static t_NetTransNum peerMvmtNext=0;
+static BOOL   peerMvmtSynced=FALSE;
+static t_NetTransNum peerKeepAlive=0;  // last keepalive heard
+static BOOL   peerKeepAliveSynced=FALSE;
+static UINT32 rxSerial=0;              // counts receive enables
+
+// Receiver link report since the last ack
+static UINT8  peerLqiMin, peerLqiMax, peerSamples, peerMvmtLost;
+static UINT16 peerLqiSum;
+
+// Counts for the report
+static UINT32 framesSent[NUM_MSG_NAMES];
+static UINT32 framesLost=0;
+static UINT32 acksDelivered=0;
+static UINT32 acksMissed=0;             // radio wasn't listening
+static UINT32 framesUnheard=0;          // no receiver on the channel
+
+static t_simTime transmit(tx_packet_t *packet);
+static void peerReceive(t_NetPacket *packet, t_simTime when);
+static void peerAck(t_NetPacket *packet, t_simTime when);
+static BOOL lost(void);
+static void logFrame(const char *dir, t_NetPacket *packet);
+
+/****************************************************************************
+ * simRadioSetup
+ *
+ * Description: Link settings, see the top of this file
+ *
+ * Parms:       lqi     - LQI the receiver hears us at
+ *              loss    - random frame loss, percent
+ *              answers - FALSE for no receiver at all
+ *              seed    - for the random loss
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simRadioSetup(UINT8 lqi, UINT8 loss, BOOL answers, UINT32 seed)
+{
+  rxLqi = lqi;
+  lossPercent = loss;
+  answer = answers;
+  lossSeed = seed;
+}
+
+/****************************************************************************
+ * simRadioSetEnergy
+ *
+ * Description: Energy detect reading for a channel, bigger is quieter
+ *
+ * Parms:       ch    - channel
+ *              level - reading
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simRadioSetEnergy(UINT8 ch, UINT8 level)
+{
+  UINT8 i;
+
+  if (!energySet) {
+    for (i=0; i<PHY_NUM_CHANNELS; i++) {
+      energy[i] = SIM_ENERGY_DEFAULT;
+    }
+    energySet = TRUE;
+  }
+  if (ch < PHY_NUM_CHANNELS) {
+    energy[ch] = level;
+  }
+}
+
+/****************************************************************************
+ * simRadioDoze
+ *
+ * Description: HAL_RF_lowpower and HAL_RF_wake_wait.  Nothing is heard
+ *              while dozing.
+ *
+ * Parms:       doze - TRUE to doze
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simRadioDoze(BOOL doze)
+{
+  dozing = doze;
+  if (doze) {
+    rxPacket = NULL;
+  }
+}
+
+/****************************************************************************
+ * simRadioNext
+ *
+ * Description: When the radio next interrupts
+ *
+ * Parms:       none
+ *
+ * Returns:     virtual time, or ~0 if nothing is coming
+ ***************************************************************************/
+t_simTime simRadioNext(void)
+{
+  t_simTime next = ~(t_simTime)0;
+
+  if (txDone != 0) {
+    next = txDone;
+  }
+  if (ackTime != 0 && ackTime < next) {
+    next = ackTime;
+  }
+  if (rxPacket != NULL && rxTimeout != 0 && rxTimeout < next) {
+    next = rxTimeout;
+  }
+  return next;
+}
+
+/****************************************************************************
+ * simRadioFire
+ *
+ * Description: The radio interrupt simRadioNext said was coming: an
+ *              asynchronous send finished, the ack arrived (if we are
+ *              listening on its channel), or the receive timed out.
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simRadioFire(void)
+{
+  rx_packet_t *pRx;
+  BOOL heard;
+
+  if (txDone != 0 && txDone <= simNow) {
+    txDone = 0;
+    simProfileStart();
+    MCPS_data_confirm(SUCCESS);
+    simProfileStop();
+    return;
+  }
+
+  if (ackTime != 0 && ackTime <= simNow) {
+    ackTime = 0;
+    heard = (rxPacket != NULL && !dozing && channel == ackChannel);
+
+    // the receiver moves once its ack is out
+    if (peerMoveTo >= 0) {
+      peerChannel = (UINT8)peerMoveTo;
+      peerMoveTo = -1;
+    }
+
+    if (!heard) {
+      acksMissed++;
+      if (simVerbose) {
+        simLog("ack  not listening");
+      }
+      return;
+    }
+    if (lost()) {
+      framesLost++;
+      simLog("lost WAH_ACK");
+      return;
+    }
+
+    pRx = rxPacket;
+    rxPacket = NULL;
+    pRx->dataLength = (UINT8)getMin(sizeof(t_NetPacket), pRx->maxDataLength);
+    memcpy(pRx->data, &ack, pRx->dataLength);
+    pRx->status = SUCCESS;
+    acksDelivered++;
+    logFrame("rx  ", &ack);
+
+    simProfileStart();
+    MCPS_data_indication(pRx);
+    simProfileStop();
+    return;
+  }
+
+  // receive timed out
+  pRx = rxPacket;
+  rxPacket = NULL;
+  pRx->status = TIMEOUT;
+  pRx->dataLength = 0;
+  simProfileStart();
+  MCPS_data_indication(pRx);
+  simProfileStop();
+}
+
+/****************************************************************************
+ * simRadioReport
+ *
+ * Description: End of run numbers
+ *
+ * Parms:       out - where to print them
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void simRadioReport(FILE *out)
+{
+  UINT8 i;
+
+  fprintf(out, "rf   channel %u power %u, receiver on channel %u\n", 
+          channel, power, peerChannel);
+  for (i=0; i<NUM_MSG_NAMES; i++) {
+    if (framesSent[i] != 0) {
+      fprintf(out, "rf   %-15s %lu sent\n", msgNames[i], framesSent[i]);
+    }
+  }
+  fprintf(out, "rf   %lu lost, %lu unheard, %lu acks received, %lu acks missed\n",
+          framesLost, framesUnheard, acksDelivered, acksMissed);
+}
+
+/****************************************************************************
+ * SMAC procedures, see simple_phy.c
+ ***************************************************************************/
+int MCPS_data_request(tx_packet_t *packet)
+{
+  t_simTime done;
+
+  if (dozing) {
+    return ERROR;
+  }
+
+  done = transmit(packet);
+  simRunUntil(done, FALSE);
+  return SUCCESS;
+}
+
+int MCPS_data_request_async(tx_packet_t *packet)
+{
+  if (dozing || txDone != 0) {
+    return ERROR;
+  }
+
+  txDone = transmit(packet);
+  return SUCCESS;
+}
+
+int MLME_RX_enable_request(rx_packet_t *packet, __uint32__ timeout)
+{
+  UINT32 serial;
+
+  if (dozing) {
+    return ERROR;
+  }
+
+  rxPacket = packet;
+  rxTimeout = (timeout != 0) ? simNow + timeout : 0;
+  serial = ++rxSerial;
+
+  // With a timeout the caller spins until the receive is over,
+  // run the clock to it here
+  if (timeout != 0) {
+    while (rxPacket != NULL && serial == rxSerial) {
+      simRunUntil(rxTimeout, TRUE);
+    }
+  }
+  return SUCCESS;
+}
+
+int MLME_RX_disable_request(void)
+{
+  rxPacket = NULL;
+  return SUCCESS;
+}
+
+int MLME_set_channel_request(__uint8__ ch)
+{
+  if (ch >= PHY_NUM_CHANNELS) {
+    return ERROR;
+  }
+  if (simVerbose && ch != channel) {
+    simLog("chan %u -> %u", channel, ch);
+  }
+  channel = ch;
+  return SUCCESS;
+}
+
+int MLME_MC13192_PA_output_adjust(__uint8__ level)
+{
+  if (level != power) {
+    simLog("pa   %u -> %u", power, level);
+  }
+  power = level;
+  return SUCCESS;
+}
+
+__uint8__ MLME_energy_detect(void)
+{
+  simRunUntil(simNow + SIM_ENERGY_TICKS, FALSE);
+  return energySet ? energy[channel] : SIM_ENERGY_DEFAULT;
+}
+
+__uint8__ MLME_link_quality(void)
+{
+  // the receiver always sends at POWER_SETTING
+  return 0xFF - rxLqi;
+}
+
+/****************************************************************************
+ * transmit
+ *
+ * Description: Puts a frame on the air, the receiver hears it at the end
+ *
+ * Parms:       packet - frame
+ *
+ * Returns:     when the frame is done
+ ***************************************************************************/
+static t_simTime transmit(tx_packet_t *packet)
+{
+  t_NetPacket frame;
+  t_simTime done;
+
+  memset(&frame, 0, sizeof(frame));
+  memcpy(&frame, packet->data, getMin(packet->dataLength, sizeof(frame)));
+
+  if (frame.msgType < NUM_MSG_NAMES) {
+    framesSent[frame.msgType]++;
+  }
+  logFrame("tx  ", &frame);
+
+  done = simNow + (t_simTime)(packet->dataLength + SIM_TX_OVERHEAD) * SIM_TX_BYTE_TICKS;
+  peerReceive(&frame, done);
+  return done;
+}
+
+/****************************************************************************
+ * peerReceive
+ *
+ * Description: The receiver end, see receiver/main.c and net.c
+ *
+ * Parms:       packet - frame the transmitter sent
+ *              when   - end of the frame
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void peerReceive(t_NetPacket *packet, t_simTime when)
+{
+  int lqi;
+  t_NetTransNum missed;
+
+  if (!answer || channel != peerChannel) {
+    framesUnheard++;
+    return;
+  }
+
+  lqi = rxLqi + ((int)power - POWER_SETTING) * SIM_LQI_PER_STEP;
+  lqi = getMax(getMin(lqi, 0xFF), 0);
+  if (lqi < SIM_RX_LQI_MIN || lost()) {
+    framesLost++;
+    if (simVerbose || (packet->msgType != WAH_MVMT && packet->msgType != WAH_ANGLE)) {
+      simLog("lost %s", packet->msgType < NUM_MSG_NAMES ? msgNames[packet->msgType] : "?");
+    }
+    return;
+  }
+
+  // link report, like linkSample in net.c
+  if (peerSamples == 0) {
+    peerLqiMin = peerLqiMax = (UINT8)lqi;
+    peerLqiSum = 0;
+  }
+  if (peerSamples < 0xFF) {
+    peerLqiMin = getMin(peerLqiMin, (UINT8)lqi);
+    peerLqiMax = getMax(peerLqiMax, (UINT8)lqi);
+    peerLqiSum += (UINT16)lqi;
+    peerSamples++;
+  }
+
+  switch (packet->msgType) {
+  case WAH_MVMT:
+  case WAH_ANGLE:
+    if (peerMvmtSynced) {
+      missed = (packet->transNum - peerMvmtNext) % MAX_NET_TRANSNUM;
+      peerMvmtLost = (UINT8)getMin(peerMvmtLost + missed, 0xFF);
+    }
+    peerMvmtSynced = TRUE;
+    peerMvmtNext = (packet->transNum + 1) % MAX_NET_TRANSNUM;
+    break;
+
+  case WAH_ON:
+    peerMvmtSynced = FALSE;
+    peerKeepAliveSynced = FALSE;
+    break;
+
+  case KEEPALIVE:
+    peerAck(packet, when);
+    break;
+
+  case WAH_CHANNEL:
+    peerAck(packet, when);
+    if (packet->netData[0] < PHY_NUM_CHANNELS) {
+      peerMoveTo = packet->netData[0];
+    }
+    break;
+  }
+}
+
+/****************************************************************************
+ * peerAck
+ *
+ * Description: The receiver's WAH_ACK with its link report, see 
+ *              setLinkReport in net.c
+ *
+ * Parms:       packet - frame being acked
+ *              when   - end of the frame
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void peerAck(t_NetPacket *packet, t_simTime when)
+{
+  UINT8 linkLost=0;
+
+  if (packet->msgType == KEEPALIVE) {
+    if (peerKeepAliveSynced) {
+      linkLost = (UINT8)(packet->transNum - (t_NetTransNum)(peerKeepAlive + 1));
+      if (linkLost >= 0x80) {
+        linkLost = 0;
+      }
+    }
+    peerKeepAliveSynced = TRUE;
+    peerKeepAlive = packet->transNum;
+  }
+
+  memcpy(ack.idString, NET_ID_STRING, NET_IDSTRING_STRLEN);
+  ack.msgType = WAH_ACK;
+  ack.transNum = peerKeepAlive;
+  ack.timestamp[NET_LINK_LQI_MIN] = peerLqiMin;
+  ack.timestamp[NET_LINK_LQI_AVG] = (UINT8)(peerLqiSum / peerSamples);
+  ack.timestamp[NET_LINK_LQI_MAX] = peerLqiMax;
+  ack.netData[NET_LINK_LOST] = linkLost;
+  ack.netData[NET_LINK_MVMT_LOST] = peerMvmtLost;
+  ack.netData[NET_LINK_SAMPLES] = peerSamples;
+  peerSamples = 0;
+  peerMvmtLost = 0;
+
+  ackTime = when + SIM_ACK_TURNAROUND;
+  ackChannel = peerChannel;
+}
+
+/****************************************************************************
+ * lost
+ *
+ * Description: Random frame loss, the same every run for a seed
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if this frame is lost
+ ***************************************************************************/
+static BOOL lost(void)
+{
+  lossSeed = lossSeed * 1103515245UL + 12345;
+  return (((lossSeed >> 16) & 0x7FFF) % 100) < lossPercent;
+}
+
+/****************************************************************************
+ * logFrame
+ *
+ * Description: Logs a frame in or out
+ *
+ * Parms:       dir    - "tx  " or "rx  "
+ *              packet - frame
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void logFrame(const char *dir, t_NetPacket *packet)
+{
+  const char *name = packet->msgType < NUM_MSG_NAMES ? msgNames[packet->msgType] : "?";
+
+  switch (packet->msgType) {
+  case KEEPALIVE:
+  case WAH_ACK:
+    simLog("%sch %2u pa %2u %-11s seq %3u lqi %u/%u/%u lost %u mvmt lost %u n %u",
+           dir, channel, power, name, packet->transNum,
+           packet->timestamp[NET_LINK_LQI_MIN], packet->timestamp[NET_LINK_LQI_AVG],
+           packet->timestamp[NET_LINK_LQI_MAX], packet->netData[NET_LINK_LOST],
+           packet->netData[NET_LINK_MVMT_LOST], packet->netData[NET_LINK_SAMPLES]);
+    break;
+
+  case WAH_ANGLE:
+    simLog("%sch %2u pa %2u %-11s seq %3u angle %d", dir, channel, power, name,
+           packet->transNum, getNetAngle(packet));
+    break;
+
+  case WAH_MVMT:
+    simLog("%sch %2u pa %2u %-11s seq %3u x %u y %u z %u", dir, channel, power, name,
+           packet->transNum, packet->netData[0], packet->netData[1], packet->netData[2]);
+    break;
+
+  case WAH_CHANNEL:
+    simLog("%sch %2u pa %2u %-11s to %u", dir, channel, power, name, packet->netData[0]);
+    break;
+
+  case WAH_ENERGY:
+    simLog("%sch %2u pa %2u %-11s ch %u level %u%s", dir, channel, power, name,
+           packet->netData[NET_ENERGY_CHANNEL], packet->netData[NET_ENERGY_LEVEL],
+           packet->netData[NET_ENERGY_IN_USE] ? " in use" : "");
+    break;
+
+  default:
+    simLog("%sch %2u pa %2u %s", dir, channel, power, name);
+    break;
+  }
+}
@@ -0,0 +1,19 @@
+// Host simulation stand-in for the SMAC MC9S08GT60 derivative header.
+// Only the registers the simulated files touch are here, as plain
+// variables the simulation looks at (see sim.c).
+#ifndef _SIM_SMAC_MC9S08GT60_H
+#define _SIM_SMAC_MC9S08GT60_H
+
+#include <string.h>
+
+typedef unsigned char byte;
+typedef unsigned short word;
+
+// Port D, the SARD LEDs (sard_board.h)
+extern volatile byte simPortD[8];
+#define PTDD_PTDD0    simPortD[0]
+#define PTDD_PTDD1    simPortD[1]
+#define PTDD_PTDD3    simPortD[3]
+#define PTDD_PTDD4    simPortD[4]
+
+#endif
@@ -0,0 +1,2 @@
+// Host simulation stand-in for the CodeWarrior stdtypes.h, nothing
+// from it is used.
@@ -1,394 +1,783 @@
-/**************************************************************
-*	This is the SMAC C source driver file for the HC(S)08 MCU
-*   and MC13192 transceiver.
-*   The driver controls all interfaces to/from the MC13192 by the
-*   SPI, selected interrupt source and MCU GPIO's assigned to
-*   other MC13192 pins.
-*   The SMAC driver is the lowest layer of C code.
-*   Actual hardware interconnects from the MCU to the MC13192 are
-*   defined in the MC13192_hw_config.h header file.
-**************************************************************/
-
-
-/**************************************************************
-*	Includes
-**************************************************************/
-#include "device_header.h"
-#include "pub_def.h"
-#include "drivers.h"
-#include "MC13192_regs.h"
-#include "MC13192_hw_config.h"
-#include "mcu_hw_config.h"
-#include "simple_phy.h"
-
-/**************************************************************
-*	Defines
-**************************************************************/
-#define AssertCE        MC13192_CE = 0 /* Asserts the MC13192 CE pin */
-#define DeAssertCE      MC13192_CE = 1 /* Deasserts the MC13192 CE pin */
-#define SPIClkInvert      SPIC1 |= 0x04; /*Set CPHA bit of SPCR (clk polarity) */
-#define SPIClkNormal      SPIC1 &= 0xFB; /*clr CPHA bit of SPCR (clk polarity) */
-
-/**************************************************************
-*	Globals
-**************************************************************/
-rx_packet_t *drv_rx_packet;
-cca_measurement_t drv_cca_reading; 
-__uint8__ irq_value = 0;
-extern byte rtx_mode;
-
-/**************************************************************
-*	Interrupt: 	MC13192 initiated interrupt handler
-*	Parameters: none
-*	Return:		The interrupt will RTI unless valid data is recvd.
-*				In this case a pd_data_indication function call-back
-*				will be executed first, followed by a RTI
-**************************************************************/
-interrupt void irq_isr(void)
-{
-  /* The vector is defined in vectortable.c */
-  volatile __uint16__ status_content, reg; /* Result of the status register read. */
-  __uint8__ dataLength = 0;		/* Data length for the RX packet */
-  CLEAR_IRQ_FLAG; /* Acknowledge the interrupt. MC13192 IRQ pin still low. */     
-  status_content = drv_read_spi_1(STATUS_ADDR); /* Read the MC13192 status register. */
-  /* Replace this with C code, if possible!!!!!!!!!!!!*/
-  /* Test for IRQ glitch or possible fast double IRQ. */
-  asm
-  {
-  BIH irq_high
-  }
-  /* IRQ is low. Re-read status. */
-  CLEAR_IRQ_FLAG; /* Acknowledge the interrupt. MC13192 IRQ pin still low. */     
-  reg = drv_read_spi_1(STATUS_ADDR); /* Read the MC13192 status register. */
-  status_content = status_content | reg; /* Actual status is the OR of both. */
-  asm
-  {
-  irq_high:
-  }
-  status_content &= TX_IRQ_MASK | RX_IRQ_MASK | ATTN_IRQ_MASK | CRC_VALID_MASK | TIMER1_IRQ_MASK | CCA_IRQ_MASK | LO_LOCK_IRQ_MASK;
-  if (rtx_mode != RX_MODE_WTO)
-  {
-  /* If timeout not being used, mask out timer. */
-		status_content &= ~(TIMER1_IRQ_MASK);
-  }
-  if ((status_content & ~(CRC_VALID_MASK)) == 0)
-  {
-  /* If no status bits are set just return. */
-		return;
-  }
-  /* DOZE Complete Interrupt */
-  if ((status_content & DOZE_IRQ_MASK) != 0)
-  {
-  /* Not implemented!!!!!!!!!!!!!! */
-  }  
-  /* ATTN IRQ Handler*/
-  if ((status_content & ATTN_IRQ_MASK) != 0)
-  {
-  /* If attn interrupt, set the rtx_state mirror. */
-  /* For MC13192 V2.x devices, read the reset indication in R25/7 first. */
-  /* If a reset is indicated, call back to a reset handler. */
-		status_content = drv_read_spi_1(RESIND_ADDR); /* Read the MC13192 reset indicator register. */
-		status_content &= RESET_BIT_MASK;
-		if (status_content == 0) /* Reset */
-		{
-			rtx_mode = MC13192_RESET_MODE; /* Set the rtx_state mirror to idle with attn. */
-			PLME_MC13192_reset_indication();
-			return;
-		}
-		else
-		{
-			rtx_mode = IDLE_MODE_ATTN; /* Set the rtx_state mirror to idle with attn. */
-			return;
-		}
-  }
-  /* TIMER1 IRQ Handler (Used for receiver timeout notification) */
-  if ((status_content & TIMER1_IRQ_MASK) != 0) 
-  {
-  /* If a timeout (and timeout enabled) is done, update the mode mirror state. */  
-	  	if (rtx_mode == RX_MODE_WTO)
-	  	{
-			/* Clear Timer1 if in RX_MODE_WTO */
-			drv_write_spi_1(T1_HI_ADDR, 0x8000); /* Disables TC1 and clears the IRQ. */
-			drv_write_spi_1(T1_LO_ADDR, 0x0000);
-			drv_rx_packet->status = TIMEOUT;
-	  		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
-			rtx_mode = IDLE_MODE;
-			/* TIMEOUT notification */
-			pd_data_indication();
-			return;
-		}
-  }
-  /* LO LOCK IRQ - Occurs when MC13192 loses LOCK */
-  /* For receive cycles, re-enable. For transmit/CCA, abort. */
-  if ((status_content & LO_LOCK_IRQ_MASK) != 0)
-  {
-  		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
-  		if ((rtx_mode == RX_MODE) || (rtx_mode == RX_MODE_WTO) || (rtx_mode == CCA_MODE)) /* Unlock from receive cycles */
-  		{
-			status_content = (drv_read_spi_1(MODE_ADDR) & 0xFF7F); /* Read the MC13192 trx register. Timer trigger off. */
-			drv_write_spi_1(MODE_ADDR, status_content); /* Re-write the trx register. */  
-	  		AssertRTXEN(); /* Re-start the sequence. */
-  		}
-  		else
-  		{
-  			rtx_mode = IDLE_MODE;
-  		}
-		return;
-  }
-  if ((rtx_mode == IDLE_MODE) || ((status_content & CCA_IRQ_MASK) != 0) || ((status_content & TX_IRQ_MASK) != 0))
-  {
-  /* If in idle mode already or if CCA or TX is done, just return. */
-  		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
-		rtx_mode = IDLE_MODE;
-		return;
-  }
-  /* If rx is done */
-  if ((status_content & RX_IRQ_MASK) != 0)
-  {  
-		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
-	  	if ((status_content & CRC_VALID_MASK) == 0)
-  		{
- 		/* If an invalid CRC, restart receiver. */
-			status_content = (drv_read_spi_1(MODE_ADDR) & 0xFF7F); /* Read the MC13192 trx register. Timer trigger off. */
-			drv_write_spi_1(MODE_ADDR, status_content); /* Update the trx register. */  		
-  			AssertRTXEN(); /* Forces the MC13192 to enter the receive mode. */
-			return;
-  		}
-  		else
-  		{
- 	  		dataLength = (__uint8__) (drv_read_spi_1(RX_PKT_LEN) & 0x7F); /* Read received packet length register and mask off length bits */
-	  		if (dataLength < 3) /* Rx_pkt_length is bad when 0, 1 or 2. */
-	  		{
-				status_content = (drv_read_spi_1(MODE_ADDR) & 0xFF7F); /* Read the MC13192 trx register. Timer trigger off. */
-				drv_write_spi_1(MODE_ADDR, status_content); /* Update the trx register. */  		
-				AssertRTXEN(); /* Forces the MC13192 to enter the receive mode. */
-				return;
-			}
-			/* A valid packet has been received. */
-			rtx_mode = IDLE_MODE;       /* set the rtx_state to idle */
-			drv_write_spi_1(T1_HI_ADDR, 0x8000); /* Disables TC1 and clears the IRQ. */
-			drv_write_spi_1(T1_LO_ADDR, 0x0000);
-			drv_rx_packet->dataLength = dataLength;
-			drv_rx_packet->status = SUCCESS;
-	   		pd_data_indication();	/* Notify PHY that there is data available. */
-			return;
-		}
-  }
-}
-
-/**************************************************************
-*	Function: 	Wake the MC13192 from Hibernate/Doze mode
-*	Parameters: none
-*	Return:		
-**************************************************************/
-void Wake_MC13192 (void)
-{
-	MC13192_ATTN = 0; /* Assert ATTN */
-	MC13192_ATTN = 1; /* Deassert ATTN */
-}
-
-/**************************************************************
-*	Function: 	Deassert the MC13192 RTXEN pin (forces IC to idle)
-*	Parameters: none
-*	Return:		
-**************************************************************/
-void DeAssertRTXEN(void)
-{
-	MC13192_RTXEN = 0; /* Deassert RTXEN */
-}
-
-/**************************************************************
-*	Function: 	Assert the MC13192 RTXEN pin (initiates programmed cycle)
-*	Parameters: none
-*	Return:		
-**************************************************************/
-void AssertRTXEN(void)
-{
-	MC13192_RTXEN = 1; /* Assert RTXEN */
-}
-
-/**************************************************************
-*	Function: 	write 1 word to SPI 
-*	Parameters: SPI address, the word
-*	Return:		
-**************************************************************/
-void drv_write_spi_1(__uint8__ addr, __uint16__ content)
-{
-   __uint8__ temp_value; /* Used to flush the SPI1D register during read */
-  temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
-  disable_MC13192_interrupts(); /* Necessary to prevent double SPI access */
-  AssertCE; /* Enables MC13192 SPI */
-  SPI1D = addr & 0x3F; /* Mask address, 6bit addr. Set write bit (i.e. 0). */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now write content MSB */
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-  SPI1D = content >> 8; /* Write MSB */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now write content LSB */
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-  SPI1D = content & 0x00FF; /* Write LSB */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now read last of garbage */
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-  DeAssertCE; /* Disables MC13192 SPI */
-  restore_MC13192_interrupts(); /* Restore MC13192 interrupt status */
-}
-
-/**************************************************************
-*	Function: 	read 1 word from SPI 
-*	Parameters: SPI address
-*	Return:		a word, w. w[0] is the MSB, w[1] is the LSB
-**************************************************************/
-__uint16__ drv_read_spi_1(__uint8__ addr)
-{
-  __uint16__  w; /* w[0] is MSB, w[1] is LSB */
-  __uint8__ temp_value; /* Used to flush the SPI1D register during read */
-  temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
-  disable_MC13192_interrupts(); /* Necessary to prevent double SPI access */
-  AssertCE; /* Enables MC13192 SPI */
-  SPI1D = (addr & 0x3f) | 0x80; /* Mask address, 6bit addr, Set read bit. */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set */
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-  SPI1D = addr; /* Dummy write. Receive register of SPI will contain MSB */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Get MSB */
-  ((__uint8__*)&w)[0] = SPI1D; /* MSB */
-  SPI1D = addr; /* Dummy write. Waiting until after reading received data insures no overrun */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Get LSB */
-  ((__uint8__*)&w)[1] = SPI1D; /* LSB */
-  DeAssertCE; /* Disables MC13192 SPI */
-  restore_MC13192_interrupts(); /* Restore MC13192 interrupt status */
-  return w;
-}
-
-/**************************************************************
-*	Parameters: None
-*	Purpose: Waits until the SPI1D has been transferred and received
-**************************************************************/
-void WaitSPI_transfer_done(void)
-{
-  while (!(SPI1S_SPRF))
-  {
-  }
-}
-
-/**************************************************************
-*	Function: 	disable MC13192 interrupts
-*	Parameters: none
-*	Return:		
-**************************************************************/
-void disable_MC13192_interrupts(void)
-{
-	irq_value = MC13192_IRQ_SOURCE;	/* Save the context of the MC13192_INT_REG (global) */
-	MC13192_IRQ_SOURCE = irq_value & ~(0x06);  /* Disable the MC13192 interrupt source */
-}
-
-/**************************************************************
-*	Function: 	restore MC13192 interrupts to previous condition
-*	Parameters: none
-*	Return:		
-**************************************************************/
-void restore_MC13192_interrupts(void)
-{
-	MC13192_IRQ_SOURCE = irq_value;	/* Restore the context of the IRQ register from global */
-	
-}
-
-
-/**************************************************************
-*	Function: write a block of data to TX packet RAM (whichever is selected)
-*	Parameters: length		length of the block of data in bytes
-*				*contents	pointer to the data block
-**************************************************************/
-void drv_write_tx_ram(tx_packet_t *tx_pkt)
-{
-  __uint8__ i, ibyte, temp_value; /* i, ibyte are counters. temp_value is used to flush the SPI1D register during read */
-  __uint16__  reg; /* TX packet length register value */
-  reg = drv_read_spi_1(TX_PKT_LEN); /* Read the TX packet length register contents */
-  reg = (0xFF80 & reg) | (tx_pkt->dataLength + 2); /* Mask out old length setting and update. Add 2 for CRC */
-  drv_write_spi_1(TX_PKT_LEN, reg); /* Update the TX packet length field */
-  temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
-  disable_MC13192_interrupts(); /* Necessary to prevent double SPI access */
-  AssertCE; /* Enables MC13192 SPI */
-  SPI1D = TX_PKT; /* SPI TX ram data register */
-  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now write content MSB */
-  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-  ibyte = 0; /* Byte counter for *contents */
-  for (i=0; i<((tx_pkt->dataLength+1) >> 1); i++) /* Word loop. Round up. */ 
-  {
- 		SPI1D = tx_pkt->data[ibyte + 1];	/* Write MSB */
-  		WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now write content LSB */
-  		temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-	  	SPI1D = tx_pkt->data[ibyte];	/* Write LSB */  		
- 		ibyte=ibyte+2; /* Increment byte counter */
-  		WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set.*/
-  		temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-  }
-  DeAssertCE; /* Disables MC13192 SPI */
-  restore_MC13192_interrupts(); /* Restore MC13192 interrupt status */
-}
-
-/**************************************************************
-*	Function: read a block of data from RX packet RAM (whichever is selected)
-*	Parameters: *length		returned length of the block of data in bytes
-*				*contents	pointer to the data block storage
-**************************************************************/
-int drv_read_rx_ram(rx_packet_t *rx_pkt)
-{
-  __uint8__ i, ibyte, temp_value; /* i, ibyte are counters. temp_value is used to flush the SPI1D register during read */
-  __uint8__  status=0; /* holder for the return value */
-  __uint16__ rx_length;
-  rx_length = drv_read_spi_1(RX_PKT_LEN); /* Read the RX packet length register contents */
-  rx_length &= 0x007F; /* Mask out all but the RX packet length */
-  /* MC13192 reports length with 2 CRC bytes, remove them. */
-  /* ShortPacket is also checked in RX_ISR */
-  if (rx_length >= 3)
-  {
-	  	rx_pkt->dataLength = rx_length - 2;
-  }
-  else
-  {
-  		rx_pkt->dataLength = 0;
-  }	
-  if ((rx_pkt->dataLength >= 1) && (rx_pkt->dataLength <= rx_pkt->maxDataLength)) /* If <3, the packet is garbage */
-  {
-  		temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
-  		temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
-  		disable_MC13192_interrupts(); /* Necessary to prevent double SPI access */
-  		AssertCE; /* Enables MC13192 SPI */
-	 	SPI1D = RX_PKT | 0x80; /* SPI RX ram data register */
-  		WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set.*/
-  		temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-		SPI1D = temp_value; /* Dummy write. Receive register of SPI will contain MSB garbage for first read */
-		WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set.*/
-  		temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-		SPI1D = temp_value; /* Dummy write. Receive register of SPI will contain LSB garbage for first read */
-		WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set.*/
-  		temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
-		ibyte = 0; /* Byte counter for *contents */
-		for (i=0; i<((rx_length-1)>>1); i++) /* Word loop. Round up. Deduct CRC. */
-		{
-			SPI1D = temp_value; /* Dummy write. Receive register of SPI will contain MSB */
-			WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Get MSB */
-			if ((ibyte+3)==rx_length) /* For a trailing garbage byte, just read and discard */
-			{
-				temp_value = SPI1D; /* Discard */
-			}
-			else
-			{
-				rx_pkt->data[ibyte+1] = SPI1D; /* Read MSB */
-			}
-			SPI1D = temp_value; /* Dummy write. Receive register of SPI will contain LSB */
-			WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Get LSB */
-			rx_pkt->data[ibyte] = SPI1D; /* Read LSB */
-	 		ibyte=ibyte+2; /* Increment byte counter */
-	 	}
-  		DeAssertCE; /* Disables MC13192 SPI */
-  		rx_pkt->status = SUCCESS;
-  		restore_MC13192_interrupts(); /* Restore MC13192 interrupt status */
-  }
-	/* Check to see if a larger packet than desired is received. */  
-  if (rx_pkt->dataLength > rx_pkt->maxDataLength)
-  rx_pkt->status = OVERFLOW;
-  return status;  
-}
-
+/**************************************************************
+*	This is the SMAC C source driver file for the HC(S)08 MCU
+*   and MC13192 transceiver.
+*   The driver controls all interfaces to/from the MC13192 by the
+*   SPI, selected interrupt source and MCU GPIO's assigned to
+*   other MC13192 pins.
+*   The SMAC driver is the lowest layer of C code.
+*   Actual hardware interconnects from the MCU to the MC13192 are
+*   defined in the MC13192_hw_config.h header file.
+**************************************************************/
+
+
+/**************************************************************
+*	Includes
+**************************************************************/
+#include "device_header.h"
+#include "pub_def.h"
+#include "drivers.h"
+#include "MC13192_regs.h"
+#include "MC13192_hw_config.h"
+#include "mcu_hw_config.h"
+#include "simple_phy.h"
+#include "common_def.h"
+
+/**************************************************************
+*	Defines
+**************************************************************/
+#define AssertCE        MC13192_CE = 0 /* Asserts the MC13192 CE pin */
+#define DeAssertCE      MC13192_CE = 1 /* Deasserts the MC13192 CE pin */
+#define SPIClkInvert      SPIC1 |= 0x04; /*Set CPHA bit of SPCR (clk polarity) */
+#define SPIClkNormal      SPIC1 &= 0xFB; /*clr CPHA bit of SPCR (clk polarity) */
+
+/* A burst runs with MCU interrupts masked. With the next byte already */
+/* loaded in SPI1D, the received byte must be read before the next one */
+/* finishes shifting (16 bus cycles) or it is lost. The CCR is saved */
+/* so a burst from inside the IRQ handler leaves interrupts masked. */
+#define SPI_BURST_BEGIN		CRITICAL_ENTER(spi_ccr)
+#define SPI_BURST_END		CRITICAL_EXIT(spi_ccr)
+#define SPI_DUMMY			0x00 /* Sent while reading */
+/* One byte is 16 bus cycles at SPI1BR = 0, a poll of SPI1S and the */
+/* loop around it at least 6, so this is over twice a byte. */
+#define SPI_LAST_BYTE_POLLS	6
+
+/* Registers kept in the RAM shadow, see drv_read_spi_shadow. */
+#define SHADOW_MODE			0
+#define SHADOW_MODE2		1
+#define SHADOW_CLKS			2 /* Also XTAL_ADJ_ADDR */
+#define SHADOW_TX_PKT_LEN	3
+#define SHADOW_LO1_IDIV		4
+#define SHADOW_LO1_NUM		5
+#define SHADOW_PA_ADJUST	6
+#define SHADOW_REGS			7
+#define SHADOW_NONE			0xFF
+
+/* Channel and power survive doze and hibernate, only a reset loses them. */
+#define SHADOW_WAKE_KEEP	((1 << SHADOW_LO1_IDIV) | (1 << SHADOW_LO1_NUM) | (1 << SHADOW_PA_ADJUST))
+
+/**************************************************************
+*	Globals
+**************************************************************/
+rx_packet_t *drv_rx_packet;
+cca_measurement_t drv_cca_reading; 
+__uint8__ irq_value = 0;
+extern byte rtx_mode;
+static __uint8__ spi_ccr; /* CCR saved by SPI_BURST_BEGIN */
+static __uint16__ shadow_content[SHADOW_REGS]; /* Last value written or read */
+static __uint8__ shadow_valid = 0; /* Bit per shadow_content entry */
+
+/**************************************************************
+*	Local prototypes
+**************************************************************/
+static void spi_begin(__uint8__);
+static void spi_put(__uint8__);
+static __uint8__ spi_get(__uint8__);
+static void spi_end(void);
+static void spi_reg_write(__uint8__, __uint16__);
+static __uint16__ spi_reg_read(__uint8__);
+static __uint16__ spi_reg_read_shadow(__uint8__);
+static __uint8__ shadow_index(__uint8__);
+static void shadow_update(__uint8__, __uint16__);
+
+/**************************************************************
+*	Interrupt: 	MC13192 initiated interrupt handler
+*	Parameters: none
+*	Return:		The interrupt will RTI unless valid data is recvd.
+*				In this case a pd_data_indication function call-back
+*				will be executed first, followed by a RTI
+**************************************************************/
+interrupt void irq_isr(void)
+{
+  /* The vector is defined in vectortable.c */
+  volatile __uint16__ status_content, reg; /* Result of the status register read. */
+  __uint8__ dataLength = 0;		/* Data length for the RX packet */
+  CLEAR_IRQ_FLAG; /* Acknowledge the interrupt. MC13192 IRQ pin still low. */     
+  status_content = drv_read_spi_1(STATUS_ADDR); /* Read the MC13192 status register. */
+  /* Replace this with C code, if possible!!!!!!!!!!!!*/
+  /* Test for IRQ glitch or possible fast double IRQ. */
+  asm
+  {
+  BIH irq_high
+  }
+  /* IRQ is low. Re-read status. */
+  CLEAR_IRQ_FLAG; /* Acknowledge the interrupt. MC13192 IRQ pin still low. */     
+  reg = drv_read_spi_1(STATUS_ADDR); /* Read the MC13192 status register. */
+  status_content = status_content | reg; /* Actual status is the OR of both. */
+  asm
+  {
+  irq_high:
+  }
+  status_content &= TX_IRQ_MASK | RX_IRQ_MASK | ATTN_IRQ_MASK | CRC_VALID_MASK | TIMER1_IRQ_MASK | CCA_IRQ_MASK | LO_LOCK_IRQ_MASK;
+  if (rtx_mode != RX_MODE_WTO)
+  {
+  /* If timeout not being used, mask out timer. */
+		status_content &= ~(TIMER1_IRQ_MASK);
+  }
+  if ((status_content & ~(CRC_VALID_MASK)) == 0)
+  {
+  /* If no status bits are set just return. */
+		return;
+  }
+  /* DOZE Complete Interrupt */
+  if ((status_content & DOZE_IRQ_MASK) != 0)
+  {
+  /* Not implemented!!!!!!!!!!!!!! */
+  }  
+  /* ATTN IRQ Handler*/
+  if ((status_content & ATTN_IRQ_MASK) != 0)
+  {
+  /* If attn interrupt, set the rtx_state mirror. */
+  /* For MC13192 V2.x devices, read the reset indication in R25/7 first. */
+  /* If a reset is indicated, call back to a reset handler. */
+		status_content = drv_read_spi_1(RESIND_ADDR); /* Read the MC13192 reset indicator register. */
+		status_content &= RESET_BIT_MASK;
+		if (status_content == 0) /* Reset */
+		{
+			drv_shadow_invalidate(); /* Registers are back to their defaults */
+			rtx_mode = MC13192_RESET_MODE; /* Set the rtx_state mirror to idle with attn. */
+			pd_data_confirm(ERROR); /* An async transmit in flight is lost. */
+			PLME_MC13192_reset_indication();
+			return;
+		}
+		else
+		{
+			shadow_valid &= SHADOW_WAKE_KEEP; /* Re-read the mode registers after a wake */
+			rtx_mode = IDLE_MODE_ATTN; /* Set the rtx_state mirror to idle with attn. */
+			return;
+		}
+  }
+  /* TIMER1 IRQ Handler (Used for receiver timeout notification) */
+  if ((status_content & TIMER1_IRQ_MASK) != 0) 
+  {
+  /* If a timeout (and timeout enabled) is done, update the mode mirror state. */  
+	  	if (rtx_mode == RX_MODE_WTO)
+	  	{
+			/* Clear Timer1 if in RX_MODE_WTO */
+			drv_write_spi_1(T1_HI_ADDR, 0x8000); /* Disables TC1 and clears the IRQ. */
+			drv_write_spi_1(T1_LO_ADDR, 0x0000);
+			drv_rx_packet->status = TIMEOUT;
+	  		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
+			rtx_mode = IDLE_MODE;
+			/* TIMEOUT notification */
+			pd_data_indication();
+			return;
+		}
+  }
+  /* LO LOCK IRQ - Occurs when MC13192 loses LOCK */
+  /* For receive cycles, re-enable. For transmit/CCA, abort. */
+  if ((status_content & LO_LOCK_IRQ_MASK) != 0)
+  {
+  		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
+  		if ((rtx_mode == RX_MODE) || (rtx_mode == RX_MODE_WTO) || (rtx_mode == CCA_MODE)) /* Unlock from receive cycles */
+  		{
+			status_content = (drv_read_spi_shadow(MODE_ADDR) & 0xFF7F); /* Read the MC13192 trx register. Timer trigger off. */
+			drv_write_spi_1(MODE_ADDR, status_content); /* Re-write the trx register. */  
+	  		AssertRTXEN(); /* Re-start the sequence. */
+  		}
+  		else
+  		{
+  			rtx_mode = IDLE_MODE;
+  			pd_data_confirm(ERROR); /* Transmit aborted */
+  		}
+		return;
+  }
+  if ((rtx_mode == IDLE_MODE) || ((status_content & CCA_IRQ_MASK) != 0) || ((status_content & TX_IRQ_MASK) != 0))
+  {
+  /* If in idle mode already or if CCA or TX is done, just return. */
+  		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
+		rtx_mode = IDLE_MODE;
+		if ((status_content & TX_IRQ_MASK) != 0)
+		{
+			pd_data_confirm(SUCCESS); /* Finish an async transmit */
+		}
+		return;
+  }
+  /* If rx is done */
+  if ((status_content & RX_IRQ_MASK) != 0)
+  {  
+		DeAssertRTXEN(); /* Forces the MC13192 to idle. */
+	  	if ((status_content & CRC_VALID_MASK) == 0)
+  		{
+ 		/* If an invalid CRC, restart receiver. */
+			status_content = (drv_read_spi_shadow(MODE_ADDR) & 0xFF7F); /* Read the MC13192 trx register. Timer trigger off. */
+			drv_write_spi_1(MODE_ADDR, status_content); /* Update the trx register. */  		
+  			AssertRTXEN(); /* Forces the MC13192 to enter the receive mode. */
+			return;
+  		}
+  		else
+  		{
+ 	  		dataLength = (__uint8__) (drv_read_spi_1(RX_PKT_LEN) & 0x7F); /* Read received packet length register and mask off length bits */
+	  		if (dataLength < 3) /* Rx_pkt_length is bad when 0, 1 or 2. */
+	  		{
+				status_content = (drv_read_spi_shadow(MODE_ADDR) & 0xFF7F); /* Read the MC13192 trx register. Timer trigger off. */
+				drv_write_spi_1(MODE_ADDR, status_content); /* Update the trx register. */  		
+				AssertRTXEN(); /* Forces the MC13192 to enter the receive mode. */
+				return;
+			}
+			/* A valid packet has been received. */
+			rtx_mode = IDLE_MODE;       /* set the rtx_state to idle */
+			drv_write_spi_1(T1_HI_ADDR, 0x8000); /* Disables TC1 and clears the IRQ. */
+			drv_write_spi_1(T1_LO_ADDR, 0x0000);
+			drv_rx_packet->dataLength = dataLength;
+			drv_rx_packet->status = SUCCESS;
+	   		pd_data_indication();	/* Notify PHY that there is data available. */
+			return;
+		}
+  }
+}
+
+/**************************************************************
+*	Function: 	Wake the MC13192 from Hibernate/Doze mode
+*	Parameters: none
+*	Return:		
+**************************************************************/
+void Wake_MC13192 (void)
+{
+	MC13192_ATTN = 0; /* Assert ATTN */
+	MC13192_ATTN = 1; /* Deassert ATTN */
+}
+
+/**************************************************************
+*	Function: 	Deassert the MC13192 RTXEN pin (forces IC to idle)
+*	Parameters: none
+*	Return:		
+**************************************************************/
+void DeAssertRTXEN(void)
+{
+	MC13192_RTXEN = 0; /* Deassert RTXEN */
+}
+
+/**************************************************************
+*	Function: 	Assert the MC13192 RTXEN pin (initiates programmed cycle)
+*	Parameters: none
+*	Return:		
+**************************************************************/
+void AssertRTXEN(void)
+{
+	MC13192_RTXEN = 1; /* Assert RTXEN */
+}
+
+/**************************************************************
+*	Function: 	write 1 word to SPI 
+*	Parameters: SPI address, the word
+*	Return:		
+**************************************************************/
+void drv_write_spi_1(__uint8__ addr, __uint16__ content)
+{
+   __uint8__ temp_value; /* Used to flush the SPI1D register during read */
+  temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
+  disable_MC13192_interrupts(); /* Necessary to prevent double SPI access */
+  AssertCE; /* Enables MC13192 SPI */
+  SPI1D = addr & 0x3F; /* Mask address, 6bit addr. Set write bit (i.e. 0). */
+  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now write content MSB */
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
+  SPI1D = content >> 8; /* Write MSB */
+  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now write content LSB */
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
+  SPI1D = content & 0x00FF; /* Write LSB */
+  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Now read last of garbage */
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
+  DeAssertCE; /* Disables MC13192 SPI */
+  shadow_update(addr, content);
+  restore_MC13192_interrupts(); /* Restore MC13192 interrupt status */
+}
+
+/**************************************************************
+*	Function: 	read 1 word from SPI 
+*	Parameters: SPI address
+*	Return:		a word, w. w[0] is the MSB, w[1] is the LSB
+**************************************************************/
+__uint16__ drv_read_spi_1(__uint8__ addr)
+{
+  __uint16__  w; /* w[0] is MSB, w[1] is LSB */
+  __uint8__ temp_value; /* Used to flush the SPI1D register during read */
+  temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
+  disable_MC13192_interrupts(); /* Necessary to prevent double SPI access */
+  AssertCE; /* Enables MC13192 SPI */
+  SPI1D = (addr & 0x3f) | 0x80; /* Mask address, 6bit addr, Set read bit. */
+  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set */
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */
+  SPI1D = addr; /* Dummy write. Receive register of SPI will contain MSB */
+  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Get MSB */
+  ((__uint8__*)&w)[0] = SPI1D; /* MSB */
+  SPI1D = addr; /* Dummy write. Waiting until after reading received data insures no overrun */
+  WaitSPI_transfer_done(); /* For this bit to be set, SPTED MUST be set. Get LSB */
+  ((__uint8__*)&w)[1] = SPI1D; /* LSB */
+  DeAssertCE; /* Disables MC13192 SPI */
+  restore_MC13192_interrupts(); /* Restore MC13192 interrupt status */
+  return w;
+}
+
+/**************************************************************
+*	Parameters: None
+*	Purpose: Waits until the SPI1D has been transferred and received
+**************************************************************/
+void WaitSPI_transfer_done(void)
+{
+  while (!(SPI1S_SPRF))
+  {
+  }
+}
+
+/**************************************************************
+*	SPI burst engine
+*   The functions below run a whole sequence of transfers inside
+*   one SPI_BURST_BEGIN/END. Writes keep the next byte loaded in
+*   SPI1D (SPTEF) while the current one shifts and never wait for
+*   the received garbage. Reads load the next dummy byte before
+*   picking up the current one. Only the burst functions may use
+*   the spi_xxx helpers, they assume interrupts are masked.
+**************************************************************/
+
+/**************************************************************
+*	Function: 	Start an SPI frame
+*	Parameters: header byte (address and read bit)
+*	Return:		
+**************************************************************/
+static void spi_begin(__uint8__ header)
+{
+  __uint8__ temp_value; /* Used to flush the SPI1D register */
+  temp_value = SPI1S; /* Clear status register (possible SPRF, SPTEF) */  
+  temp_value = SPI1D; /* Clear receive data register. SPI entirely ready for read or write */                       
+  AssertCE; /* Enables MC13192 SPI */
+  SPI1D = header; /* Shifter is idle, goes straight out */
+}
+
+/**************************************************************
+*	Function: 	Queue one byte behind the one shifting
+*	Parameters: the byte
+*	Return:		
+**************************************************************/
+static void spi_put(__uint8__ data)
+{
+  while (!(SPI1S_SPTEF))
+  {
+  }
+  SPI1D = data;
+}
+
+/**************************************************************
+*	Function: 	Read the byte shifting now, queueing a dummy
+*				behind it first if more are to come.
+*	Parameters: bytes left to read, including this one
+*	Return:		the byte
+**************************************************************/
+static __uint8__ spi_get(__uint8__ left)
+{
+  if (left > 1)
+  {
+  	spi_put(SPI_DUMMY);
+  }
+  WaitSPI_transfer_done(); /* SPRF, this byte is in */
+  return SPI1D;
+}
+
+/**************************************************************
+*	Function: 	Wait for the last byte written to go out and
+*				end the SPI frame
+*	Parameters: none
+*	Return:		
+*	Note:	Writes never read SPI1D, so SPRF is stuck from the
+*			first byte and can't say when the last one is done.
+*			Once SPTEF is set the last byte is in the shifter,
+*			SPI_LAST_BYTE_POLLS reads of SPI1S outlast it whatever
+*			the C around it costs.
+**************************************************************/
+static void spi_end(void)
+{
+  __uint8__ temp_value; /* Used to flush the SPI1D register */
+  __uint8__ i;
+  while (!(SPI1S_SPTEF)) /* Last byte moved to the shifter */
+  {
+  }
+  for (i=SPI_LAST_BYTE_POLLS; i>0; i--)
+  {
+  	temp_value = SPI1S;
+  }
+  temp_value = SPI1D; /* Clear SPRF */
+  DeAssertCE; /* Disables MC13192 SPI */
+}
+
+/**************************************************************
+*	Function: 	Write 1 word, inside a burst
+*	Parameters: SPI address, the word
+*	Return:		
+**************************************************************/
+static void spi_reg_write(__uint8__ addr, __uint16__ content)
+{
+  spi_begin(addr & 0x3F); /* Mask address, 6bit addr. Set write bit (i.e. 0). */
+  spi_put((__uint8__)(content >> 8)); /* MSB */
+  spi_put((__uint8__)content); /* LSB */
+  spi_end();
+  shadow_update(addr, content);
+}
+
+/**************************************************************
+*	Function: 	Read 1 word, inside a burst
+*	Parameters: SPI address
+*	Return:		the word
+**************************************************************/
+static __uint16__ spi_reg_read(__uint8__ addr)
+{
+  __uint16__ w; /* w[0] is MSB, w[1] is LSB */
+  spi_begin((addr & 0x3F) | 0x80); /* Mask address, 6bit addr, Set read bit. */
+  (void)spi_get(3); /* Header, garbage */
+  ((__uint8__*)&w)[0] = spi_get(2); /* MSB */
+  ((__uint8__*)&w)[1] = spi_get(1); /* LSB */
+  DeAssertCE; /* Disables MC13192 SPI */
+  return w;
+}
+
+/**************************************************************
+*	Function: 	Read 1 word through the shadow, inside a burst
+*	Parameters: SPI address
+*	Return:		the word
+**************************************************************/
+static __uint16__ spi_reg_read_shadow(__uint8__ addr)
+{
+  __uint8__ i;
+  i = shadow_index(addr);
+  if (i == SHADOW_NONE)
+  {
+  	return spi_reg_read(addr);
+  }
+  if ((shadow_valid & (1 << i)) == 0)
+  {
+  	shadow_content[i] = spi_reg_read(addr);
+  	shadow_valid |= (1 << i);
+  }
+  return shadow_content[i];
+}
+
+/**************************************************************
+*	Function: 	Write a sequence of registers in one burst
+*	Parameters: table of address/word pairs, number of pairs
+*	Return:		
+**************************************************************/
+void drv_write_spi_burst(const spi_reg_t *regs, __uint8__ count)
+{
+  SPI_BURST_BEGIN;
+  while (count-- > 0)
+  {
+  	spi_reg_write(regs->addr, regs->content);
+  	regs++;
+  }
+  SPI_BURST_END;
+}
+
+/**************************************************************
+*	Function: 	Read a sequence of registers in one burst
+*	Parameters: table of address/word pairs, number of pairs.
+*				The words are filled in.
+*	Return:		
+**************************************************************/
+void drv_read_spi_burst(spi_reg_t *regs, __uint8__ count)
+{
+  SPI_BURST_BEGIN;
+  while (count-- > 0)
+  {
+  	regs->content = spi_reg_read(regs->addr);
+  	regs++;
+  }
+  SPI_BURST_END;
+}
+
+/**************************************************************
+*	Register shadow
+*   The PHY reads MODE, MODE2, CLKS and TX_PKT_LEN back before
+*   changing a field on every state change. Every write through
+*   the driver updates a RAM copy, so the read only goes to the
+*   SPI the first time after a reset or ATTN invalidates it. The
+*   LO1 and PA copies are only dropped by a reset, so setting the
+*   same channel and power again on every wake costs no SPI. Only
+*   registers the MC13192 never changes on its own can be kept.
+**************************************************************/
+
+/**************************************************************
+*	Function: 	Find a register in the shadow
+*	Parameters: SPI address
+*	Return:		shadow index, SHADOW_NONE if not shadowed
+**************************************************************/
+static __uint8__ shadow_index(__uint8__ addr)
+{
+	switch (addr)
+	{
+	case MODE_ADDR:
+		return SHADOW_MODE;
+	case MODE2_ADDR:
+		return SHADOW_MODE2;
+	case CLKS_ADDR:
+		return SHADOW_CLKS;
+	case TX_PKT_LEN:
+		return SHADOW_TX_PKT_LEN;
+	case LO1_IDIV_ADDR:
+		return SHADOW_LO1_IDIV;
+	case LO1_NUM_ADDR:
+		return SHADOW_LO1_NUM;
+	case PA_ADJUST_ADDR:
+		return SHADOW_PA_ADJUST;
+	default:
+		return SHADOW_NONE;
+	}
+}
+
+/**************************************************************
+*	Function: 	Keep the shadow coherent with a register write
+*	Parameters: SPI address, the word written
+*	Return:		
+**************************************************************/
+static void shadow_update(__uint8__ addr, __uint16__ content)
+{
+  __uint8__ i;
+  i = shadow_index(addr);
+  if (i != SHADOW_NONE)
+  {
+  	shadow_content[i] = content;
+  	shadow_valid |= (1 << i);
+  }
+}
+
+/**************************************************************
+*	Function: 	Read 1 word, from the shadow if it has a copy
+*	Parameters: SPI address
+*	Return:		the word
+**************************************************************/
+__uint16__ drv_read_spi_shadow(__uint8__ addr)
+{
+  __uint8__ i;
+  i = shadow_index(addr);
+  if (i == SHADOW_NONE)
+  {
+  	return drv_read_spi_1(addr);
+  }
+  if ((shadow_valid & (1 << i)) == 0)
+  {
+  	shadow_content[i] = drv_read_spi_1(addr);
+  	shadow_valid |= (1 << i);
+  }
+  return shadow_content[i];
+}
+
+/**************************************************************
+*	Function: 	Write 1 word, unless the shadow shows the register
+*				already holds it
+*	Parameters: SPI address, the word
+*	Return:		TRUE if written
+**************************************************************/
+__uint8__ drv_write_spi_changed(__uint8__ addr, __uint16__ content)
+{
+  __uint8__ i;
+  i = shadow_index(addr);
+  if ((i != SHADOW_NONE) && ((shadow_valid & (1 << i)) != 0) && (shadow_content[i] == content))
+  {
+  	return FALSE;
+  }
+  drv_write_spi_1(addr, content);
+  return TRUE;
+}
+
+/**************************************************************
+*	Function: 	Forget the shadow, the MC13192 was reset
+*	Parameters: none
+*	Return:		
+**************************************************************/
+void drv_shadow_invalidate(void)
+{
+  shadow_valid = 0;
+}
+
+/**************************************************************
+*	Function: 	disable MC13192 interrupts
+*	Parameters: none
+*	Return:		
+**************************************************************/
+void disable_MC13192_interrupts(void)
+{
+	irq_value = MC13192_IRQ_SOURCE;	/* Save the context of the MC13192_INT_REG (global) */
+	MC13192_IRQ_SOURCE = irq_value & ~(0x06);  /* Disable the MC13192 interrupt source */
+}
+
+/**************************************************************
+*	Function: 	restore MC13192 interrupts to previous condition
+*	Parameters: none
+*	Return:		
+**************************************************************/
+void restore_MC13192_interrupts(void)
+{
+	MC13192_IRQ_SOURCE = irq_value;	/* Restore the context of the IRQ register from global */
+	
+}
+
+
+/**************************************************************
+*	Function: write a block of data to TX packet RAM (whichever is selected)
+*	Parameters: length		length of the block of data in bytes
+*				*contents	pointer to the data block
+*	Note:	The length update and the data go out in one burst, the
+*			data streams with the next byte loaded while one shifts.
+*			The length is only written when it changes.
+**************************************************************/
+void drv_write_tx_ram(tx_packet_t *tx_pkt)
+{
+  __uint8__ i, *data; /* i is the word counter */
+  __uint16__  reg, new_reg; /* TX packet length register value */
+  SPI_BURST_BEGIN;
+  reg = spi_reg_read_shadow(TX_PKT_LEN); /* Read the TX packet length register contents */
+  new_reg = (0xFF80 & reg) | (tx_pkt->dataLength + 2); /* Mask out old length setting and update. Add 2 for CRC */
+  if (new_reg != reg) /* Same length as last time, nothing to write */
+  {
+  	spi_reg_write(TX_PKT_LEN, new_reg); /* Update the TX packet length field */
+  }
+  spi_begin(TX_PKT); /* SPI TX ram data register */
+  data = tx_pkt->data;
+  for (i=0; i<((tx_pkt->dataLength+1) >> 1); i++) /* Word loop. Round up. */ 
+  {
+  	spi_put(data[1]); /* Write MSB */
+  	spi_put(data[0]); /* Write LSB */
+  	data += 2;
+  }
+  spi_end();
+  SPI_BURST_END;
+}
+
+/**************************************************************
+*	Function: read a block of data from RX packet RAM (whichever is selected)
+*	Parameters: *length		returned length of the block of data in bytes
+*				*contents	pointer to the data block storage
+*	Note:	The length read and the data come in one burst, each
+*			dummy byte is loaded before the previous byte is read.
+**************************************************************/
+int drv_read_rx_ram(rx_packet_t *rx_pkt)
+{
+  __uint8__ i, words, left, *data; /* Word counter, words to read, bytes left to clock in */
+  __uint8__ msb; /* MSB is read before it is known to be wanted */
+  __uint8__  status=0; /* holder for the return value */
+  __uint16__ rx_length;
+  SPI_BURST_BEGIN;
+  rx_length = spi_reg_read(RX_PKT_LEN); /* Read the RX packet length register contents */
+  rx_length &= 0x007F; /* Mask out all but the RX packet length */
+  /* MC13192 reports length with 2 CRC bytes, remove them. */
+  /* ShortPacket is also checked in RX_ISR */
+  if (rx_length >= 3)
+  {
+	  	rx_pkt->dataLength = rx_length - 2;
+  }
+  else
+  {
+  		rx_pkt->dataLength = 0;
+  }	
+  if ((rx_pkt->dataLength >= 1) && (rx_pkt->dataLength <= rx_pkt->maxDataLength)) /* If <3, the packet is garbage */
+  {
+		words = (__uint8__)((rx_length-1) >> 1); /* Round up. Deduct CRC. */
+		left = (words << 1) + 3; /* Header, one garbage word, the data */
+  		spi_begin(RX_PKT | 0x80); /* SPI RX ram data register */
+		(void)spi_get(left--); /* Header */
+		(void)spi_get(left--); /* MSB garbage for first read */
+		(void)spi_get(left--); /* LSB garbage for first read */
+		data = rx_pkt->data;
+		for (i=0; i<words; i++)
+		{
+			msb = spi_get(left--);
+			data[0] = spi_get(left--); /* Read LSB */
+			if ((i+1 < words) || ((rx_pkt->dataLength & 1) == 0)) /* A trailing garbage byte is discarded */
+			{
+				data[1] = msb; /* MSB */
+			}
+			data += 2;
+	 	}
+  		DeAssertCE; /* Disables MC13192 SPI */
+  		rx_pkt->status = SUCCESS;
+  }
+  SPI_BURST_END;
+	/* Check to see if a larger packet than desired is received. */  
+  if (rx_pkt->dataLength > rx_pkt->maxDataLength)
+  rx_pkt->status = OVERFLOW;
+  return status;  
+}
+
+
+#if defined (SPI_BENCHMARK)
+/**************************************************************
+*	Function: 	Read TPM1, free running at the bus clock
+*	Parameters: none
+*	Return:		counter
+**************************************************************/
+static __uint16__ bench_ticks(void)
+{
+  __uint16__ w;
+  ((__uint8__*)&w)[0] = TPM1CNTH; /* MSB, latches LSB */
+  ((__uint8__*)&w)[1] = TPM1CNTL; /* LSB */
+  return w;
+}
+
+/**************************************************************
+*	Function: 	Time the common SPI sequences in bus cycles.
+*				Borrows TPM1 at the full bus clock, so call it
+*				when nothing else is timing with TPM1. The MC13192
+*				must be idle. The channel is left as it was.
+*	Parameters: results
+*	Return:		
+**************************************************************/
+void drv_spi_benchmark(spi_benchmark_t *result)
+{
+  static __uint8__ data[SPI_BENCHMARK_PKT_LEN];
+  static tx_packet_t pkt;
+  static spi_reg_t regs[2];
+  __uint16__ start, overhead, idiv, num;
+  __uint8__ tpm_sc, channel;
+
+  pkt.data = data;
+  pkt.dataLength = SPI_BENCHMARK_PKT_LEN;
+  regs[0].addr = STATUS_ADDR;
+
+  tpm_sc = TPM1SC;
+  TPM1SC = 0x08; /* BUSCLK, no prescale */
+  TPM1CNTH = 0; /* Any write resets the counter */
+
+  start = bench_ticks();
+  overhead = bench_ticks() - start; /* Cost of reading the timer */
+
+  start = bench_ticks();
+  drv_write_tx_ram(&pkt);
+  result->tx_packet = bench_ticks() - start - overhead;
+
+  start = bench_ticks();
+  (void)drv_read_spi_1(STATUS_ADDR);
+  result->status_read = bench_ticks() - start - overhead;
+
+  start = bench_ticks();
+  drv_read_spi_burst(regs, 1);
+  result->status_burst = bench_ticks() - start - overhead;
+
+  idiv = drv_read_spi_1(LO1_IDIV_ADDR);
+  num = drv_read_spi_1(LO1_NUM_ADDR);
+  regs[0].addr = LO1_IDIV_ADDR;
+  regs[0].content = idiv;
+  regs[1].addr = LO1_NUM_ADDR;
+  regs[1].content = num;
+
+  start = bench_ticks();
+  drv_write_spi_1(LO1_IDIV_ADDR, idiv);
+  drv_write_spi_1(LO1_NUM_ADDR, num);
+  result->channel_set = bench_ticks() - start - overhead;
+
+  start = bench_ticks();
+  drv_write_spi_burst(regs, 2);
+  result->channel_burst = bench_ticks() - start - overhead;
+
+  /* Channel switch through the PHY, then back, then the no-op */
+  channel = PLME_get_channel_request();
+  start = bench_ticks();
+  (void)PLME_set_channel_request((channel + 1) % PHY_NUM_CHANNELS);
+  result->channel_switch = bench_ticks() - start - overhead;
+  (void)PLME_set_channel_request(channel);
+
+  start = bench_ticks();
+  (void)PLME_set_channel_request(channel);
+  result->channel_same = bench_ticks() - start - overhead;
+
+  TPM1SC = tpm_sc;
+}
+#endif
@@ -1,51 +1,85 @@
-/**************************************************************
-*	This is the SMAC C source driver header file for the HCS08 MCU
-*   and MC13192 transceiver.
-*   The header defines all externals, prototypes and MC13192
-*   status mask bits used by the actual C driver.
-**************************************************************/
-
-
-/**************************************************************
-*	Includes
-**************************************************************/
-#include "device_header.h"
-#include "pub_def.h"
-
-/**************************************************************
-*	Externals
-**************************************************************/
-extern byte rtx_mode; /* Global mode mirror. */
-
-/**************************************************************
-*	Defines
-*   MC13192 status register interrupt masks.
-**************************************************************/
-#define CLEAR_IRQ_FLAG			IRQSC_IRQACK = 1 /* Dependent upon interrupt source chosen. */
-#define TX_IRQ_MASK				0x0040
-#define RAMERR_IRQ_MASK			0x4000
-#define RX_IRQ_MASK				0x0080
-#define ATTN_IRQ_MASK			0x0400
-#define CRC_VALID_MASK			0x0001
-#define TIMER1_IRQ_MASK			0x0100
-#define XCVR_SEQ_MASK			0xFFF8
-#define LO_LOCK_IRQ_MASK		0x8000
-#define CCA_IRQ_MASK			0x0020
-#define DOZE_IRQ_MASK			0x0200
-#define RESET_BIT_MASK			0x0080
-
-/**************************************************************
-*	Prototypes
-*   See drivers.c for a complete description.
-**************************************************************/
-void WaitSPI_transfer_done(void);
-void disable_MC13192_interrupts(void);
-void restore_MC13192_interrupts(void);
-void Wake_MC13192 (void);
-void DeAssertRTXEN(void);
-void AssertRTXEN(void);
-void drv_write_spi_1(__uint8__, __uint16__);
-__uint16__ drv_read_spi_1(__uint8__);
-void drv_write_tx_ram(tx_packet_t *);
-int drv_read_rx_ram(rx_packet_t *);
-
+/**************************************************************
+*	This is the SMAC C source driver header file for the HCS08 MCU
+*   and MC13192 transceiver.
+*   The header defines all externals, prototypes and MC13192
+*   status mask bits used by the actual C driver.
+**************************************************************/
+
+
+/**************************************************************
+*	Includes
+**************************************************************/
+#include "device_header.h"
+#include "pub_def.h"
+
+/**************************************************************
+*	Externals
+**************************************************************/
+extern byte rtx_mode; /* Global mode mirror. */
+
+/**************************************************************
+*	Defines
+*   MC13192 status register interrupt masks.
+**************************************************************/
+#define CLEAR_IRQ_FLAG			IRQSC_IRQACK = 1 /* Dependent upon interrupt source chosen. */
+#define TX_IRQ_MASK				0x0040
+#define RAMERR_IRQ_MASK			0x4000
+#define RX_IRQ_MASK				0x0080
+#define ATTN_IRQ_MASK			0x0400
+#define CRC_VALID_MASK			0x0001
+#define TIMER1_IRQ_MASK			0x0100
+#define XCVR_SEQ_MASK			0xFFF8
+#define LO_LOCK_IRQ_MASK		0x8000
+#define CCA_IRQ_MASK			0x0020
+#define DOZE_IRQ_MASK			0x0200
+#define RESET_BIT_MASK			0x0080
+
+/**************************************************************
+*	Types
+**************************************************************/
+/* One register of a burst sequence, see drv_write_spi_burst. */
+typedef struct
+{
+	__uint8__ addr;
+	__uint16__ content;
+} spi_reg_t;
+
+#if defined (SPI_BENCHMARK)
+/* Bus cycles for common SPI sequences, see drv_spi_benchmark. */
+typedef struct
+{
+	__uint16__ tx_packet;		/* drv_write_tx_ram, SPI_BENCHMARK_PKT_LEN bytes */
+	__uint16__ status_read;		/* drv_read_spi_1(STATUS_ADDR) */
+	__uint16__ status_burst;	/* Same, through drv_read_spi_burst */
+	__uint16__ channel_set;		/* LO1 IDIV and NUM, drv_write_spi_1 */
+	__uint16__ channel_burst;	/* Same, through drv_write_spi_burst */
+	__uint16__ channel_switch;	/* PLME_set_channel_request, new channel */
+	__uint16__ channel_same;	/* PLME_set_channel_request, same channel */
+} spi_benchmark_t;
+
+#define SPI_BENCHMARK_PKT_LEN	11 /* sizeof(t_NetPacket) */
+#endif
+
+/**************************************************************
+*	Prototypes
+*   See drivers.c for a complete description.
+**************************************************************/
+void WaitSPI_transfer_done(void);
+void disable_MC13192_interrupts(void);
+void restore_MC13192_interrupts(void);
+void Wake_MC13192 (void);
+void DeAssertRTXEN(void);
+void AssertRTXEN(void);
+void drv_write_spi_1(__uint8__, __uint16__);
+__uint16__ drv_read_spi_1(__uint8__);
+void drv_write_tx_ram(tx_packet_t *);
+int drv_read_rx_ram(rx_packet_t *);
+void drv_write_spi_burst(const spi_reg_t *, __uint8__);
+void drv_read_spi_burst(spi_reg_t *, __uint8__);
+__uint16__ drv_read_spi_shadow(__uint8__);
+__uint8__ drv_write_spi_changed(__uint8__, __uint16__);
+void drv_shadow_invalidate(void);
+#if defined (SPI_BENCHMARK)
+void drv_spi_benchmark(spi_benchmark_t *);
+#endif
+
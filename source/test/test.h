@@ -0,0 +1,37 @@
+#ifndef _TEST_H
+#define _TEST_H
+
+// Host tests for the firmware modules, see each test_*.c for how to
+// build it.  They run on a PC with the stand-in headers in ../sim, a
+// test prints what it measured and exits non zero if a check failed.
+
+#include <stdio.h>
+#include <time.h>
+
+static int testFailures=0;
+
+// Counts and reports a failed check, carries on with the rest
+#define TEST_CHECK(cond, msg) \
+  do { \
+    if (!(cond)) { \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+      testFailures++; \
+    } \
+  } while (0)
+
+// Last line of main()
+#define TEST_DONE() \
+  (printf("%s\n", testFailures ? "FAILED" : "passed"), testFailures != 0)
+
+// Host time in ns for the benchmarks, only good for comparing two
+// versions on the same PC
+static double testNs(void) __attribute__((unused));
+static double testNs(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,146 @@
+/****************************************************************************
+* test_atan2.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	test_atan2.c
+* 
+* Host test for fixedAtan2() (common/fixed_trig.c).  Checks the error
+* against libm over every input pair in -300..300, including the zero
+* vector and the axes, and times it against the old receiver table path
+* (a 32 bit divide into a 45.0-69.9 degree table).  The old table was
+* deleted with trigtables.h, it is rebuilt here from libm, which is 
+* within a tenth of the old entries.  It also ended at 69.9, not the
+* 71.9 its comment said.
+*
+* Build and run from the top of the tree:
+*
+*   gcc -O2 -Wall -DHOST_SIM -Isource/sim -Isource/common -o test_atan2 \
+*       source/test/test_atan2.c source/common/fixed_trig.c -lm
+*   ./test_atan2
+*
+****************************************************************************/
+#include <math.h>
+#include "test.h"
+#include "fixed_trig.h"
+
+#define ATAN2_RANGE           300
+#define ATAN2_MAX_ERROR       0.1     // degrees
+#define BENCH_PASSES          20
+
+// Old receiver path, see fixedArcTangent2() before fixed_trig.c
+#define ARCTANGENT_PRECISION  1000
+#define ARCTANGENT_NORMALIZE  1000
+#define ARCTANGENT_NUMENTRIES 1751    // 1.000-2.750, 45.0-69.9 degrees
+
+static short fixedArcTangentTable[ARCTANGENT_NUMENTRIES];
+
+static int fixedArcTangent2(long tanRad1, long tanRad2)
+{
+  static long tanRadians;
+  int tanAngle = 0;
+
+  tanRad1 *= ARCTANGENT_PRECISION;
+
+  if (tanRad2>0) {
+    tanRadians = tanRad1/tanRad2;
+    tanRadians -= ARCTANGENT_NORMALIZE;
+    if (tanRadians >= 0 && tanRadians < ARCTANGENT_NUMENTRIES) {
+      tanAngle = fixedArcTangentTable[tanRadians];
+    }
+  }
+
+  return tanAngle;
+}
+
+// Exact angle in degrees 0-360 like fixedAtan2
+static double refAngle(int y, int x)
+{
+  double deg = atan2((double)y, (double)x) * 180.0 / M_PI;
+
+  return (deg < 0) ? deg + 360.0 : deg;
+}
+
+int main(void)
+{
+  int    x, y, pass, got, oldDead=0, inTable=0;
+  long   sum=0;
+  double err, maxErr=0, oldMaxErr=0, start, newNs, oldNs;
+  int    worstX=0, worstY=0;
+
+  for (x=0; x<ARCTANGENT_NUMENTRIES; x++) {
+    fixedArcTangentTable[x] = (short)floor(atan((double)(x + ARCTANGENT_NORMALIZE) / ARCTANGENT_PRECISION) 
+                                           * 1800.0 / M_PI + 0.5);
+  }
+
+  TEST_CHECK(fixedAtan2(0, 0) == FIXED_ATAN2_INVALID, "zero vector not invalid");
+  TEST_CHECK(fixedAtan2(0, 100) == 0, "+x axis not 0");
+  TEST_CHECK(fixedAtan2(100, 0) == FIXED_ANGLE_90_DEG, "+y axis not 90");
+  TEST_CHECK(fixedAtan2(0, -100) == FIXED_ANGLE_180_DEG, "-x axis not 180");
+  TEST_CHECK(fixedAtan2(-100, 0) == 3 * FIXED_ANGLE_90_DEG, "-y axis not 270");
+  TEST_CHECK(fixedAtan2(32767, 32767) == 450, "full scale 45 degrees");
+
+  for (y=-ATAN2_RANGE; y<=ATAN2_RANGE; y++) {
+    for (x=-ATAN2_RANGE; x<=ATAN2_RANGE; x++) {
+      if (x == 0 && y == 0) {
+        continue;
+      }
+      got = fixedAtan2((INT16)y, (INT16)x);
+      TEST_CHECK(got >= 0 && got < FIXED_ANGLE_360_DEG, "angle out of range");
+
+      err = fabs(got / 10.0 - refAngle(y, x));
+      if (err > 180.0) {
+        err = 360.0 - err;    // either side of 0
+      }
+      if (err > maxErr) {
+        maxErr = err;
+        worstX = x;
+        worstY = y;
+      }
+
+      // the old path only ever saw first quadrant readings
+      if (x > 0 && y > 0) {
+        got = fixedArcTangent2(y, x);
+        if (got == 0) {
+          oldDead++;
+        } else {
+          inTable++;
+          err = fabs(got / 10.0 - refAngle(y, x));
+          oldMaxErr = (err > oldMaxErr) ? err : oldMaxErr;
+        }
+      }
+    }
+  }
+
+  printf("fixedAtan2  max error %.3f degrees at (%d,%d)\n", maxErr, worstY, worstX);
+  printf("old table   max error %.3f degrees, %d of %d first quadrant inputs came back 0\n", 
+         oldMaxErr, oldDead, oldDead + inTable);
+  TEST_CHECK(maxErr <= ATAN2_MAX_ERROR, "fixedAtan2 error over a tenth of a degree");
+
+  // Same first quadrant inputs through both
+  start = testNs();
+  for (pass=0; pass<BENCH_PASSES; pass++) {
+    for (y=1; y<=ATAN2_RANGE; y++) {
+      for (x=1; x<=ATAN2_RANGE; x++) {
+        sum += fixedAtan2((INT16)y, (INT16)x);
+      }
+    }
+  }
+  newNs = (testNs() - start) / (BENCH_PASSES * ATAN2_RANGE * ATAN2_RANGE);
+
+  start = testNs();
+  for (pass=0; pass<BENCH_PASSES; pass++) {
+    for (y=1; y<=ATAN2_RANGE; y++) {
+      for (x=1; x<=ATAN2_RANGE; x++) {
+        sum += fixedArcTangent2(y, x);
+      }
+    }
+  }
+  oldNs = (testNs() - start) / (BENCH_PASSES * ATAN2_RANGE * ATAN2_RANGE);
+
+  // The host divides in hardware, the HCS08 doesn't, so the old path 
+  // is flattered here.  The 32 bit divide is a library loop on the 
+  // board.
+  printf("host time   fixedAtan2 %.1fns, old table %.1fns (checksum %ld)\n", newNs, oldNs, sum);
+
+  return TEST_DONE();
+}
@@ -0,0 +1,240 @@
+/****************************************************************************
+* test_filter.c
+*
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	test_filter.c
+*
+* Host test for the run state filter (transmitter/filter.c).  Checks the
+* DC gain is exactly 1 and the lag on a ramp is the FILTER_GROUP_DELAY_MS
+* the build checks against, then measures what the lag buys:
+*
+*   - white noise, output vs input standard deviation
+*   - a recorded trace, held at FILTER_SAMPLE_MS like the run state reads
+*     it.  Roughness is the RMS change from one output to the next, the
+*     jitter the receiver would see, against taking every Rth sample raw.
+*
+* Build and run from the top of the tree:
+*
+*   gcc -O2 -Wall -DHOST_SIM -Isource/sim -Isource/common \
+*       -Isource/transmitter -Isource/smac4.0 -o test_filter \
+*       source/test/test_filter.c source/transmitter/filter.c -lm
+*   ./test_filter [trace]
+*
+* The trace defaults to source/sim/sample.trace.  To compare settings
+* add them to the gcc line, one build per setting, e.g. 
+* -DFILTER_CIC_ORDER=2 or -DFILTER_DECIMATION_SHIFT=2 -DFILTER_IIR_SHIFT=1.
+*
+****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "test.h"
+#include "filter.h"
+
+#define PRIME_SAMPLES         (FILTER_DECIMATION * (FILTER_CIC_ORDER + 16))
+#define RAMP_SAMPLES          256
+#define NOISE_SAMPLES         65536L
+#define NOISE_SPAN            40          // +-20 counts
+#define MAX_TRACE_SAMPLES     65536L
+#define BENCH_PASSES          64
+
+static t_Filter filter;
+
+// One sample on all axes, TRUE with the output if there was one
+static BOOL feed(UINT8 value, UINT8 *out)
+{
+  UINT8 in[FILTER_NUM_AXES];
+
+  memset(in, value, sizeof(in));
+  return filterSample(&filter, in, out);
+}
+
+// Every constant has to come out as itself once the filter is primed
+static void testDc(void)
+{
+  UINT8 out[FILTER_NUM_AXES];
+  int value, n, errors=0;
+
+  for (value=0; value<256; value++) {
+    filterInit(&filter);
+    for (n=0; n<PRIME_SAMPLES; n++) {
+      if (feed((UINT8)value, out) &&
+          (out[0] != value || out[1] != value || out[2] != value)) {
+        errors++;
+      }
+    }
+  }
+  printf("dc      %d of 256 levels off after priming\n", errors);
+  TEST_CHECK(errors == 0, "DC gain isn't 1");
+}
+
+// A ramp comes out delayed by the group delay.  The output for the
+// sample at n is compared with the ramp, averaged over the outputs
+// after the IIR has settled.
+static void testRamp(void)
+{
+  UINT8 out[FILTER_NUM_AXES];
+  double lag=0;
+  int n, outputs=0;
+
+  filterInit(&filter);
+  for (n=0; n<PRIME_SAMPLES; n++) {
+    feed(0, out);
+  }
+  for (n=0; n<RAMP_SAMPLES; n++) {
+    if (feed((UINT8)n, out) && n >= RAMP_SAMPLES / 2) {
+      lag += n - out[0];
+      outputs++;
+    }
+  }
+  lag /= outputs;
+
+  // Shifting out the CIC gain truncates, which can add up to a count,
+  // a sample on this ramp
+  printf("lag     %.1f samples, %.1f ms, filter.h says %d ms (limit %d)\n",
+         lag, lag * FILTER_SAMPLE_MS, FILTER_GROUP_DELAY_MS,
+         FILTER_MAX_GROUP_DELAY_MS);
+  TEST_CHECK(lag >= FILTER_GROUP_DELAY_HALVES / 2.0 &&
+             lag <= FILTER_GROUP_DELAY_HALVES / 2.0 + 1.0,
+             "ramp lag doesn't match FILTER_GROUP_DELAY_HALVES");
+}
+
+static double stdDev(double sum, double sumSq, long count)
+{
+  double mean = sum / count;
+
+  return sqrt(sumSq / count - mean * mean);
+}
+
+static void testNoise(void)
+{
+  UINT8 out[FILTER_NUM_AXES];
+  double inSum=0, inSq=0, outSum=0, outSq=0, in, ratio;
+  long n, outputs=0;
+  UINT8 value;
+
+  srand(1);
+  filterInit(&filter);
+  for (n=0; n<PRIME_SAMPLES; n++) {
+    feed(128, out);
+  }
+  for (n=0; n<NOISE_SAMPLES; n++) {
+    value = (UINT8)(128 - NOISE_SPAN / 2 + rand() % (NOISE_SPAN + 1));
+    in = value;
+    inSum += in;
+    inSq += in * in;
+    if (feed(value, out)) {
+      outSum += out[0];
+      outSq += (double)out[0] * out[0];
+      outputs++;
+    }
+  }
+
+  ratio = stdDev(outSum, outSq, outputs) / stdDev(inSum, inSq, NOISE_SAMPLES);
+  printf("noise   +-%d counts white, std dev x%.3f (%.1f dB)\n",
+         NOISE_SPAN / 2, ratio, 20 * log10(ratio));
+  TEST_CHECK(ratio < 1.0, "filter doesn't reduce noise");
+}
+
+// Reads a wahsim trace and holds each line's readings for as many
+// FILTER_SAMPLE_MS samples as it lasts.  Returns the sample count.
+static long loadTrace(const char *name, UINT8 (*samples)[FILTER_NUM_AXES])
+{
+  FILE *f;
+  char line[200];
+  long time, lastTime=-1, count=0;
+  int x, y, z;
+  UINT8 held[FILTER_NUM_AXES];
+
+  f = fopen(name, "r");
+  if (f == NULL) {
+    return 0;
+  }
+
+  while (fgets(line, sizeof(line), f) != NULL && count < MAX_TRACE_SAMPLES) {
+    if (sscanf(line, "%ld %d %d %d", &time, &x, &y, &z) != 4) {
+      continue;
+    }
+    if (lastTime >= 0) {
+      for (; lastTime < time && count < MAX_TRACE_SAMPLES; lastTime += FILTER_SAMPLE_MS) {
+        memcpy(samples[count++], held, sizeof(held));
+      }
+    } else {
+      lastTime = time;
+    }
+    held[0] = (UINT8)x;
+    held[1] = (UINT8)y;
+    held[2] = (UINT8)z;
+  }
+  fclose(f);
+  return count;
+}
+
+static void testTrace(const char *name)
+{
+  static UINT8 samples[MAX_TRACE_SAMPLES][FILTER_NUM_AXES];
+  UINT8 out[FILTER_NUM_AXES], lastOut[FILTER_NUM_AXES];
+  UINT8 raw[FILTER_NUM_AXES], lastRaw[FILTER_NUM_AXES];
+  double rawSq=0, outSq=0, d, start, ns;
+  long count, n, outputs=0, pass;
+  UINT8 i;
+  BOOL first=TRUE;
+
+  count = loadTrace(name, samples);
+  TEST_CHECK(count > 0, "couldn't read the trace");
+  if (count == 0) {
+    return;
+  }
+
+  filterInit(&filter);
+  for (n=0; n<count; n++) {
+    if (!filterSample(&filter, samples[n], out)) {
+      continue;
+    }
+    memcpy(raw, samples[n], sizeof(raw));
+    if (!first) {
+      for (i=0; i<FILTER_NUM_AXES; i++) {
+        d = (double)raw[i] - lastRaw[i];
+        rawSq += d * d;
+        d = (double)out[i] - lastOut[i];
+        outSq += d * d;
+      }
+      outputs++;
+    }
+    first = FALSE;
+    memcpy(lastRaw, raw, sizeof(raw));
+    memcpy(lastOut, out, sizeof(out));
+  }
+
+  printf("trace   %s, %ld samples, %ld outputs\n", name, count, outputs);
+  if (outputs > 0) {
+    printf("        roughness %.2f counts raw every %d, %.2f filtered (%.1f dB)\n",
+           sqrt(rawSq / outputs / FILTER_NUM_AXES), FILTER_DECIMATION,
+           sqrt(outSq / outputs / FILTER_NUM_AXES),
+           rawSq > 0 && outSq > 0 ? 10 * log10(outSq / rawSq) : 0.0);
+  }
+
+  start = testNs();
+  for (pass=0; pass<BENCH_PASSES; pass++) {
+    filterInit(&filter);
+    for (n=0; n<count; n++) {
+      filterSample(&filter, samples[n], out);
+    }
+  }
+  ns = (testNs() - start) / ((double)BENCH_PASSES * count);
+  printf("        filterSample %.1f ns per sample here\n", ns);
+}
+
+int main(int argc, char **argv)
+{
+  printf("filter  R=%d order %d iir shift %d, %d ms samples\n",
+         FILTER_DECIMATION, FILTER_CIC_ORDER, FILTER_IIR_SHIFT,
+         FILTER_SAMPLE_MS);
+
+  testDc();
+  testRamp();
+  testNoise();
+  testTrace(argc > 1 ? argv[1] : "source/sim/sample.trace");
+
+  return TEST_DONE();
+}
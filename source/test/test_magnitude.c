@@ -0,0 +1,132 @@
+/****************************************************************************
+* test_magnitude.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	test_magnitude.c
+* 
+* Host test for vectorMagnitude() (common/common_lib.c).  Checks every
+* one of the 256^3 readings against the 32 bit isqrt() movementSample()
+* used to call, and times the two.  The exact methods have to match
+* everywhere, then JOLT_DETECTION_THRESHHOLD and NO_MOVEMENT_DEVIATION 
+* mean what they did.  MAGNITUDE_ALPHA_BETA can't, for it the error and
+* how many jolt calls change are printed instead.
+*
+* Build and run from the top of the tree, once per method:
+*
+*   gcc -O2 -Wall -DHOST_SIM -DSARD -Isource/sim -Isource/common \
+*       -Isource/transmitter -Isource/smac4.0 -o test_magnitude \
+*       source/test/test_magnitude.c source/common/common_lib.c
+*   ./test_magnitude
+*
+* with -DMAGNITUDE_METHOD=MAGNITUDE_ALPHA_BETA (or MAGNITUDE_ISQRT32) 
+* on both files for the others.
+*
+****************************************************************************/
+#include <stdlib.h>
+#include "test.h"
+#include "common_def.h"
+#include "accelerometer.h"
+
+#define JOLT_PAIRS            1000000L
+#define BENCH_PASSES          4
+
+static const char *methodNames[] = {"MAGNITUDE_ISQRT32", "MAGNITUDE_ISQRT16", "MAGNITUDE_ALPHA_BETA"};
+
+// What movementSample() did before vectorMagnitude()
+static UINT16 isqrtMagnitude(UINT8 x, UINT8 y, UINT8 z)
+{
+  long sumOfSquares;
+
+  sumOfSquares  = (long)x * x;
+  sumOfSquares += (long)y * y;
+  sumOfSquares += (long)z * z;
+
+  return (UINT16)isqrt(sumOfSquares);
+}
+
+int main(void)
+{
+  long   x, y, z, i, mismatches=0, joltChanged=0, sum=0;
+  int    got, want, err, minErr=0, maxErr=0;
+  int    a1, a2, b1, b2;
+  double pctErr, minPct=0, maxPct=0, start, newNs, oldNs;
+
+  printf("%s\n", methodNames[MAGNITUDE_METHOD]);
+
+  for (x=0; x<256; x++) {
+    for (y=0; y<256; y++) {
+      for (z=0; z<256; z++) {
+        got  = vectorMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+        want = isqrtMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+        if (got != want) {
+          mismatches++;
+        }
+        err = got - want;
+        minErr = getMin(minErr, err);
+        maxErr = getMax(maxErr, err);
+
+        // the percentage only means something away from 0
+        if (want >= 64) {
+          pctErr = 100.0 * err / want;
+          minPct = getMin(minPct, pctErr);
+          maxPct = getMax(maxPct, pctErr);
+        }
+      }
+    }
+  }
+
+  printf("error %+d..%+d counts, %+.1f%%..%+.1f%% at 64 and up, %ld of 16777216 differ\n", 
+         minErr, maxErr, minPct, maxPct, mismatches);
+
+  // A jolt is two samples JOLT_DETECTION_THRESHHOLD or more apart,
+  // see how often random pairs get a different answer
+  srand(1);
+  for (i=0; i<JOLT_PAIRS; i++) {
+    x = rand() & 0xFF; y = rand() & 0xFF; z = rand() & 0xFF;
+    a1 = vectorMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+    b1 = isqrtMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+    x = rand() & 0xFF; y = rand() & 0xFF; z = rand() & 0xFF;
+    a2 = vectorMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+    b2 = isqrtMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+    if ((abs(a1 - a2) >= JOLT_DETECTION_THRESHHOLD) != (abs(b1 - b2) >= JOLT_DETECTION_THRESHHOLD)) {
+      joltChanged++;
+    }
+  }
+  printf("jolt call changed for %ld of %ld random sample pairs\n", joltChanged, JOLT_PAIRS);
+
+#if MAGNITUDE_METHOD != MAGNITUDE_ALPHA_BETA
+  TEST_CHECK(mismatches == 0, "exact method doesn't match isqrt()");
+  TEST_CHECK(joltChanged == 0, "jolt threshold behaves differently");
+#endif
+
+  // Every reading, through both
+  start = testNs();
+  for (i=0; i<BENCH_PASSES; i++) {
+    for (x=0; x<256; x++) {
+      for (y=0; y<256; y+=3) {
+        for (z=0; z<256; z+=3) {
+          sum += vectorMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+        }
+      }
+    }
+  }
+  newNs = testNs() - start;
+
+  start = testNs();
+  for (i=0; i<BENCH_PASSES; i++) {
+    for (x=0; x<256; x++) {
+      for (y=0; y<256; y+=3) {
+        for (z=0; z<256; z+=3) {
+          sum += isqrtMagnitude((UINT8)x, (UINT8)y, (UINT8)z);
+        }
+      }
+    }
+  }
+  oldNs = testNs() - start;
+
+  // The host does 32 bit math in one instruction, on the HCS08 the
+  // isqrt() side is a lot slower still
+  printf("host time   vectorMagnitude %.1f%% of isqrt() (checksum %ld)\n", 100.0 * newNs / oldNs, sum);
+
+  return TEST_DONE();
+}
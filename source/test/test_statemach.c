@@ -0,0 +1,273 @@
+/****************************************************************************
+* test_statemach.c
+*
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	test_statemach.c
+*
+* Host test for the transmitter state table (transmitter/statemach.c).
+* Every event and timer is dispatched in every state, and for the
+* conditional transitions once with the action saying go and once with
+* it saying stay.  Each time the state stMachDispatch returns, the
+* transition it reports and the exit and entry actions it ran have to
+* be what the table says.
+*
+* statemach.c is included so the test can read the table.  Everything
+* it calls is a stand-in here: the accelerometer answers come from
+* actionResult and the entry and exit actions are recognized by calls
+* only they make.
+*
+* Build and run from the top of the tree:
+*
+*   gcc -O2 -Wall -DHOST_SIM -DSARD -Isource/sim -Isource/common \
+*       -Isource/transmitter -Isource/smac4.0 -o test_statemach \
+*       source/test/test_statemach.c
+*   ./test_statemach
+*
+****************************************************************************/
+#include <string.h>
+#include "test.h"
+#include "statemach.c"
+
+#define NO_STATE              MAX_STATES
+
+static const char *stateNames[] = {"idle", "ready", "run"};
+static const char *triggerNames[] = {
+  "NIL_EVENT", "SYSTEM_INIT", "MVMT_SAMPLE_READY", "TIMER_EXPIRED",
+  "MVMT_OCCURED", "ACK_RECEIVED", "ACK_TIMEOUT", "KB_PRESS", "KB_EVENT",
+  "IDLE_LOOP_WAIT", "ACK_WAIT_TIMER", "KEEPALIVE_SEND_TIMER", "IDLE_TIMER",
+  "KB_DEBOUNCE_TIMER", "KB_POLL_TIMER", "READY_FLASH_TIMER",
+  "GESTURE_DEBOUNCE_TIMER"};
+
+typedef char stateNamesCheck[(sizeof(stateNames)/sizeof(stateNames[0]) == MAX_STATES) ? 1 : -1];
+typedef char triggerNamesCheck[(sizeof(triggerNames)/sizeof(triggerNames[0]) == ST_NUM_TRIGGERS) ? 1 : -1];
+
+volatile t_CADB GlobalData;
+
+// What the conditional actions decide
+static BOOL actionResult;
+
+// What the last dispatch did
+static UINT8 entered, exited, changeFrom, changeTo, changeTrigger;
+static int changes;
+
+static void clearLog(void)
+{
+  entered = exited = changeFrom = changeTo = NO_STATE;
+  changeTrigger = ST_NUM_TRIGGERS;
+  changes = 0;
+}
+
+void simStateChange(t_AppStates from, t_AppStates to, UINT8 trigger)
+{
+  changeFrom = from;
+  changeTo = to;
+  changeTrigger = trigger;
+  changes++;
+}
+
+// Entry and exit actions, each found by a call only it makes
+void HAL_RF_lowpower(void)          { entered = IDLE_STATE; }
+void HAL_RF_wake_wait(void)         { entered = READY_STATE; }
+void runLed(BOOL on_off)            { if (on_off) entered = RUN_STATE; }
+
+void stopTimer(t_TimerId timerId)
+{
+  if (timerId == KEEPALIVE_SEND_TIMER) {
+    exited = READY_STATE;
+  } else if (timerId == GESTURE_DEBOUNCE_TIMER) {
+    exited = RUN_STATE;
+  }
+}
+
+// The conditional actions
+int movementDetected(void)          { return actionResult; }
+int gestureOnDetected(void)         { return actionResult; }
+int gestureOffDetected(tAccSample accSample, int gestureOffAcceleration)
+{
+  return actionResult;
+}
+
+// lowPowerHandler goes straight through to a sample
+BOOL eventsPending(void)            { return FALSE; }
+BOOL sampleClockDue(void)           { return TRUE; }
+BOOL getNextDeadline(t_time *deadline) { *deadline = 0; return TRUE; }
+void HAL_getTicks(t_time *time)     { *time = 0; }
+void HAL_MCU_sleep(UINT8 time_val, int deep) {}
+void HAL_MCU_sleepFine(UINT8 time_val) {}
+
+// and the run state's filter has an output every sample
+void filterInit(t_Filter *filter)   {}
+BOOL filterSample(t_Filter *filter, const UINT8 *in, UINT8 *out)
+{
+  memset(out, 128, FILTER_NUM_AXES);
+  return TRUE;
+}
+
+// The rest only has to be there
+void movementInit(short sampleRate) {}
+int  movementSample(void)           { return FALSE; }
+void gestureInit()                  {}
+void ACC_startScan(void)            {}
+BOOL ACC_read(tAccSample *xVal, tAccSample *yVal, tAccSample *zVal)
+{
+  *xVal = *yVal = *zVal = 128;
+  return TRUE;
+}
+INT16 fixedAtan2(INT16 y, INT16 x)  { return 450; }
+void setSampleClock(int sampleMs)   {}
+void startTimer(t_TimerId timerId, BOOL restartOnTimeout) {}
+void alarmRFProblem(BOOL on_off)    {}
+void readyLedFlash()                {}
+void adjustRFPower(BOOL acked)      {}
+int  sendRFMessage(t_NetMsgType msgType) { return TRUE; }
+BOOL isRFSendBusy(void)             { return FALSE; }
+int  sendRFAngle(INT16 angle)       { return TRUE; }
+int  sendRFMovement(t_NetData x, t_NetData y, t_NetData z) { return TRUE; }
+int  rcvRFData(t_NetCallback pCallback) { return TRUE; }
+int  stopReceive(void)              { return TRUE; }
+BOOL selectQuietRFChannel(void)     { return TRUE; }
+
+// Dispatches one trigger, returns the new state
+static t_AppStates dispatch(t_AppStates state, UINT8 trigger)
+{
+  t_Event event;
+
+  memset(&event, 0, sizeof(event));
+  if (trigger < MAX_EVENTS) {
+    event.eventId = (t_EventId)trigger;
+  } else {
+    event.eventId = TIMER_EXPIRED;
+    event.timerId = trigger - MAX_EVENTS;
+  }
+  event.pCADB = (t_CADB *)&GlobalData;
+
+  // conditional actions that depend on run state settling first
+  gestureOffDetect = TRUE;
+
+  clearLog();
+  return stMachDispatch(state, &event);
+}
+
+static void walkTable(void)
+{
+  const t_StTransition *trans;
+  t_AppStates state, got;
+  UINT8 trigger, expect, pass;
+  int cells=0, moves=0, stays=0, bad=0;
+
+  for (state=0; state<MAX_STATES; state++) {
+    for (trigger=0; trigger<ST_NUM_TRIGGERS; trigger++) {
+      trans = &stTable[state][trigger];
+      cells++;
+
+      // conditional ones both ways, the rest once
+      for (pass=0; pass<(trans->action != NULL && trans->next != ST_STAY ? 2 : 1); pass++) {
+        actionResult = (pass == 0);
+        got = dispatch(state, trigger);
+
+        if (trans->next == ST_STAY || (trans->action != NULL && !actionResult)) {
+          expect = state;
+          stays++;
+          if (got != state || changes != 0 || entered != NO_STATE || exited != NO_STATE) {
+            printf("  %s on %s: left the state\n", stateNames[state], triggerNames[trigger]);
+            bad++;
+          }
+          continue;
+        }
+
+        expect = trans->next;
+        moves++;
+        printf("  %-5s -> %-5s on %s%s\n", stateNames[state], stateNames[expect],
+               triggerNames[trigger], trans->action != NULL ? " if the action says so" : "");
+        if (got != expect || changes != 1 || changeFrom != state ||
+            changeTo != expect || changeTrigger != trigger) {
+          printf("  %s on %s: went to %d, not %s\n", stateNames[state],
+                 triggerNames[trigger], got, stateNames[expect]);
+          bad++;
+        }
+        if (entered != expect) {
+          printf("  %s on %s: %s entry action not run\n", stateNames[state],
+                 triggerNames[trigger], stateNames[expect]);
+          bad++;
+        }
+        if (exited != (stExit[state] != NULL ? state : NO_STATE)) {
+          printf("  %s on %s: wrong exit action\n", stateNames[state],
+                 triggerNames[trigger]);
+          bad++;
+        }
+      }
+    }
+  }
+
+  printf("table   %d cells, %d transitions, %d stays, %d wrong\n",
+         cells, moves, stays, bad);
+  TEST_CHECK(bad == 0, "dispatch doesn't match the state table");
+}
+
+// Every state has to be reachable from idle and get back there
+static void checkReachable(void)
+{
+  BOOL reach[MAX_STATES], back[MAX_STATES], more;
+  t_AppStates state;
+  UINT8 trigger, next;
+
+  memset(reach, 0, sizeof(reach));
+  memset(back, 0, sizeof(back));
+  reach[IDLE_STATE] = back[IDLE_STATE] = TRUE;
+
+  do {
+    more = FALSE;
+    for (state=0; state<MAX_STATES; state++) {
+      for (trigger=0; trigger<ST_NUM_TRIGGERS; trigger++) {
+        next = stTable[state][trigger].next;
+        if (next == ST_STAY) {
+          continue;
+        }
+        if (reach[state] && !reach[next]) {
+          reach[next] = more = TRUE;
+        }
+        if (back[next] && !back[state]) {
+          back[state] = more = TRUE;
+        }
+      }
+    }
+  } while (more);
+
+  for (state=0; state<MAX_STATES; state++) {
+    TEST_CHECK(reach[state], "state can't be reached from idle");
+    TEST_CHECK(back[state], "state can't get back to idle");
+  }
+}
+
+// Nonsense in, nothing happens
+static void checkBadInput(void)
+{
+  t_Event event;
+  t_AppStates got;
+
+  memset(&event, 0, sizeof(event));
+  event.eventId = TIMER_EXPIRED;
+  event.timerId = MAX_TIMERS;
+  clearLog();
+  got = stMachDispatch(READY_STATE, &event);
+  TEST_CHECK(got == READY_STATE && changes == 0, "unknown timer changed state");
+
+  event.eventId = MAX_EVENTS;
+  clearLog();
+  got = stMachDispatch(RUN_STATE, &event);
+  TEST_CHECK(got == RUN_STATE && changes == 0, "unknown event changed state");
+
+  event.eventId = SYSTEM_INIT;
+  clearLog();
+  got = stMachDispatch(MAX_STATES, &event);
+  TEST_CHECK(got == MAX_STATES && changes == 0, "unknown state changed state");
+}
+
+int main(void)
+{
+  walkTable();
+  checkReachable();
+  checkBadInput();
+
+  return TEST_DONE();
+}
@@ -0,0 +1,354 @@
+/****************************************************************************
+* test_timer.c
+*
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	test_timer.c
+*
+* Host test for the deadline list in transmitter/timer.c.  The clock, the
+* event queue and the timer handlers are stand-ins here, so the test
+* decides what time it is and sees every event handleLoopTimer posts.
+*
+*   - the basics: a timer fires at its deadline and not before, stops,
+*     restarts on its beat, and timers expiring together are all posted
+*     in tmrHandlers order
+*   - a long random run of starts, stops and clock steps, across the
+*     24 bit wrap, against a plain model of what should fire when
+*   - the sample clock and getNextDeadline
+*   - what handleLoopTimer and a start/stop pair cost on this PC
+*
+* Build and run from the top of the tree:
+*
+*   gcc -O2 -Wall -DHOST_SIM -DSARD -Isource/sim -Isource/common \
+*       -Isource/transmitter -Isource/smac4.0 -o test_timer \
+*       source/test/test_timer.c source/transmitter/timer.c
+*   ./test_timer
+*
+****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "timer.h"
+
+#define RANDOM_STEPS          1000000L
+#define MAX_RANDOM_TIMEOUT_MS 12
+#define MAX_RANDOM_STEP_MS    15
+#define BENCH_CALLS           10000000L
+
+// 24 bit clock, started just short of the wrap
+#define START_TICKS           (MAX_TIME_VALUE - 2000)
+
+extern t_TmrHandlers tmrHandlers[];
+
+static unsigned long long clockTicks;   // never wraps, the HAL's does
+
+// What handleLoopTimer posted, in order
+static short posted[64];
+static int numPosted;
+static int numCancelled;
+
+// Handlers that post NIL_EVENT, one bit per timer
+static UINT16 silentTimers;
+
+void HAL_getTicks(t_time *time)
+{
+  *time = (t_time)(clockTicks & MAX_TIME_VALUE);
+}
+
+BOOL postEvent(t_EventId eventId, short timerId)
+{
+  if (eventId == TIMER_EXPIRED && numPosted < 64) {
+    posted[numPosted++] = timerId;
+  }
+  return TRUE;
+}
+
+void cancelEvent(t_EventId eventId, short timerId)
+{
+  (void)timerId;
+  if (eventId == TIMER_EXPIRED) {
+    numCancelled++;
+  }
+}
+
+static int expired(t_Event *event, t_TimerId timerId)
+{
+  event->eventId = (silentTimers & (1 << timerId)) ? NIL_EVENT : TIMER_EXPIRED;
+  event->timerId = timerId;
+  return 0;
+}
+
+int ackWaitTimer(t_Event *event)         { return expired(event, ACK_WAIT_TIMER); }
+int keepAliveTimer(t_Event *event)       { return expired(event, KEEPALIVE_SEND_TIMER); }
+int idleTimer(t_Event *event)            { return expired(event, IDLE_TIMER); }
+int kbDebounceTimer(t_Event *event)      { return expired(event, KB_DEBOUNCE_TIMER); }
+int kbPollTimer(t_Event *event)          { return expired(event, KB_POLL_TIMER); }
+int readyFlashTimer(t_Event *event)      { return expired(event, READY_FLASH_TIMER); }
+int gestureDebounceTimer(t_Event *event) { return expired(event, GESTURE_DEBOUNCE_TIMER); }
+
+static void advanceMs(long ms)
+{
+  clockTicks += (unsigned long long)ms * TIMER_TICKS_PER_MS;
+}
+
+// Runs the timers once, returns how many were posted
+static int runTimers(void)
+{
+  t_Event event;
+
+  numPosted = 0;
+  memset(&event, 0, sizeof(event));
+  handleLoopTimer(&event);
+  return numPosted;
+}
+
+static void reset(void)
+{
+  int id;
+
+  stopAllTimers();
+  setSampleClock(0);
+  silentTimers = 0;
+  numCancelled = 0;
+  clockTicks = START_TICKS;
+  for (id=0; id<MAX_TIMERS; id++) {
+    tmrHandlers[id].timeoutMs = 10;
+  }
+}
+
+static void testBasics(void)
+{
+  int id, i;
+  BOOL inOrder;
+
+  // fires at the deadline, once, not a tick before
+  reset();
+  startTimer(IDLE_TIMER, FALSE);
+  clockTicks += 10 * TIMER_TICKS_PER_MS - 1;
+  TEST_CHECK(runTimers() == 0, "timer fired early");
+  clockTicks++;
+  TEST_CHECK(runTimers() == 1 && posted[0] == IDLE_TIMER, "timer didn't fire at its deadline");
+  advanceMs(100);
+  TEST_CHECK(runTimers() == 0, "one shot timer fired again");
+
+  // stopped timers don't fire and their posted event is cancelled
+  reset();
+  startTimer(IDLE_TIMER, TRUE);
+  advanceMs(5);
+  stopTimer(IDLE_TIMER);
+  advanceMs(100);
+  TEST_CHECK(runTimers() == 0, "stopped timer fired");
+  TEST_CHECK(numCancelled == 1, "stopTimer didn't cancel the posted event");
+
+  // starting a running timer starts it over
+  reset();
+  startTimer(IDLE_TIMER, FALSE);
+  advanceMs(8);
+  startTimer(IDLE_TIMER, FALSE);
+  advanceMs(8);
+  TEST_CHECK(runTimers() == 0, "restarted timer kept its old deadline");
+  advanceMs(2);
+  TEST_CHECK(runTimers() == 1, "restarted timer didn't fire");
+
+  // all due in the same call, in tmrHandlers order whatever the
+  // start order or deadline
+  reset();
+  for (id=MAX_TIMERS-1; id>=0; id--) {
+    tmrHandlers[id].timeoutMs = 10 + id % 3;
+    startTimer(id, FALSE);
+  }
+  advanceMs(20);
+  TEST_CHECK(runTimers() == MAX_TIMERS, "not every expired timer was posted");
+  inOrder = TRUE;
+  for (i=0; i<MAX_TIMERS; i++) {
+    inOrder = inOrder && posted[i] == i;
+  }
+  TEST_CHECK(inOrder, "expired timers not posted in tmrHandlers order");
+
+  // a handler can decide not to post
+  reset();
+  silentTimers = 1 << KB_POLL_TIMER;
+  startTimer(KB_POLL_TIMER, FALSE);
+  startTimer(IDLE_TIMER, FALSE);
+  advanceMs(10);
+  TEST_CHECK(runTimers() == 1 && posted[0] == IDLE_TIMER, "NIL_EVENT was posted");
+
+  // restarting timers keep their beat when run late, and start
+  // over from now if they fell a whole period behind
+  reset();
+  startTimer(KB_POLL_TIMER, TRUE);
+  advanceMs(13);
+  TEST_CHECK(runTimers() == 1, "periodic timer didn't fire");
+  advanceMs(7);
+  TEST_CHECK(runTimers() == 1, "periodic timer drifted");
+  advanceMs(35);
+  TEST_CHECK(runTimers() == 1, "periodic timer fired more than once per call");
+  advanceMs(9);
+  TEST_CHECK(runTimers() == 0, "periodic timer didn't start over from now");
+  advanceMs(1);
+  TEST_CHECK(runTimers() == 1, "periodic timer lost after falling behind");
+
+  printf("basics  done\n");
+}
+
+// Random starts, stops and clock steps against a model that keeps
+// absolute deadlines in 64 bits
+static void testRandom(void)
+{
+  unsigned long long deadline[MAX_TIMERS], timeout;
+  BOOL running[MAX_TIMERS], restart[MAX_TIMERS];
+  t_time next, expect;
+  long step, fired=0, together=0, mismatches=0;
+  int id, n, i, op;
+
+  reset();
+  srand(1);
+  for (id=0; id<MAX_TIMERS; id++) {
+    running[id] = FALSE;
+  }
+
+  for (step=0; step<RANDOM_STEPS; step++) {
+    op = rand() % 8;
+    id = rand() % MAX_TIMERS;
+
+    if (op < 3) {
+      tmrHandlers[id].timeoutMs = 1 + rand() % MAX_RANDOM_TIMEOUT_MS;
+      restart[id] = rand() & 1;
+      startTimer(id, restart[id]);
+      running[id] = TRUE;
+      deadline[id] = clockTicks + (unsigned long long)tmrHandlers[id].timeoutMs * TIMER_TICKS_PER_MS;
+    } else if (op == 3) {
+      stopTimer(id);
+      running[id] = FALSE;
+    } else if (op == 4 && rand() % 64 == 0) {
+      stopAllTimers();
+      memset(running, 0, sizeof(running));
+    } else {
+      clockTicks += rand() % (MAX_RANDOM_STEP_MS * TIMER_TICKS_PER_MS);
+      n = runTimers();
+
+      // what should have fired, in id order
+      i = 0;
+      for (id=0; id<MAX_TIMERS; id++) {
+        if (!running[id] || deadline[id] > clockTicks) {
+          continue;
+        }
+        if (i >= n || posted[i] != id) {
+          mismatches++;
+        }
+        i++;
+        if (restart[id]) {
+          timeout = (unsigned long long)tmrHandlers[id].timeoutMs * TIMER_TICKS_PER_MS;
+          deadline[id] += timeout;
+          if (deadline[id] <= clockTicks) {
+            deadline[id] = clockTicks + timeout;
+          }
+        } else {
+          running[id] = FALSE;
+        }
+      }
+      if (i != n) {
+        mismatches++;
+      }
+      fired += n;
+      if (n > 1) {
+        together++;
+      }
+
+      // and the next deadline is the first one left
+      expect = (t_time)((clockTicks + TIMER_HALF_RANGE - 1) & MAX_TIME_VALUE);
+      for (id=0; id<MAX_TIMERS; id++) {
+        if (running[id] &&
+            (((deadline[id] - clockTicks) & MAX_TIME_VALUE) <
+             ((expect - clockTicks) & MAX_TIME_VALUE))) {
+          expect = (t_time)(deadline[id] & MAX_TIME_VALUE);
+        }
+      }
+      getNextDeadline(&next);
+      if (next != expect) {
+        mismatches++;
+      }
+    }
+  }
+
+  printf("random  %ld steps, %ld fired, %ld calls with more than one, %ld mismatches\n",
+         RANDOM_STEPS, fired, together, mismatches);
+  TEST_CHECK(mismatches == 0, "timers don't match the model");
+}
+
+static void testSampleClock(void)
+{
+  t_time deadline;
+  long ms, dues=0;
+  BOOL isSample;
+
+  reset();
+  setSampleClock(4);
+  for (ms=0; ms<4000; ms++) {
+    advanceMs(1);
+    if (sampleClockDue()) {
+      dues++;
+    }
+  }
+  TEST_CHECK(dues == 1000, "sample clock didn't keep its beat");
+
+  // more than a period behind starts over, no burst
+  advanceMs(13);
+  TEST_CHECK(sampleClockDue(), "late sample not due");
+  TEST_CHECK(!sampleClockDue(), "sample clock burst after falling behind");
+  advanceMs(4);
+  TEST_CHECK(sampleClockDue(), "sample clock didn't start over from now");
+
+  // the sample clock is only the deadline when it is first
+  isSample = getNextDeadline(&deadline);
+  TEST_CHECK(isSample && deadline == ((clockTicks + 4 * TIMER_TICKS_PER_MS) & MAX_TIME_VALUE),
+             "sample clock isn't the next deadline");
+  tmrHandlers[KB_POLL_TIMER].timeoutMs = 2;
+  startTimer(KB_POLL_TIMER, FALSE);
+  isSample = getNextDeadline(&deadline);
+  TEST_CHECK(!isSample && deadline == ((clockTicks + 2 * TIMER_TICKS_PER_MS) & MAX_TIME_VALUE),
+             "earlier timer isn't the next deadline");
+
+  printf("sample  %ld samples in 4 s at 4 ms\n", dues);
+}
+
+static void benchmark(void)
+{
+  double start, loopNs, startStopNs;
+  long n;
+  int id;
+
+  // every timer running, none due, the usual case each time
+  // through the main loop
+  reset();
+  for (id=0; id<MAX_TIMERS; id++) {
+    tmrHandlers[id].timeoutMs = 20000;
+    startTimer(id, FALSE);
+  }
+  start = testNs();
+  for (n=0; n<BENCH_CALLS; n++) {
+    clockTicks++;
+    runTimers();
+  }
+  loopNs = (testNs() - start) / BENCH_CALLS;
+
+  start = testNs();
+  for (n=0; n<BENCH_CALLS; n++) {
+    id = n % MAX_TIMERS;
+    stopTimer(id);
+    startTimer(id, FALSE);
+  }
+  startStopNs = (testNs() - start) / BENCH_CALLS;
+
+  printf("bench   handleLoopTimer %.1f ns, stop and start %.1f ns here, %d timers running\n",
+         loopNs, startStopNs, MAX_TIMERS);
+}
+
+int main(void)
+{
+  testBasics();
+  testRandom();
+  testSampleClock();
+  benchmark();
+
+  return TEST_DONE();
+}
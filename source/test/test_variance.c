@@ -0,0 +1,161 @@
+/****************************************************************************
+* test_variance.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	test_variance.c
+* 
+* Host test for the running sum variance in accelerometer.c.  Feeds 
+* windows of readings through movementSample() and compares calcVariance()
+* with the old loop over every sample, done two ways:
+*
+*   - with 32 bit int, the loop as it read.  Must match bit for bit.
+*   - with the HCS08's 16 bit int.  vInt*vInt wrapped there for any
+*     sample more than 181 from the mean, so the old code on the board
+*     got those windows wrong.  The new code is exact on purpose, this
+*     only counts how often the board's answer changes.
+*
+* Build and run from the top of the tree:
+*
+*   gcc -O2 -Wall -DHOST_SIM -DSARD -Isource/sim -Isource/common \
+*       -Isource/transmitter -Isource/smac4.0 -o test_variance \
+*       source/test/test_variance.c source/transmitter/accelerometer.c \
+*       source/common/common_lib.c
+*   ./test_variance
+*
+****************************************************************************/
+#include <stdlib.h>
+#include "test.h"
+#include "accelerometer.h"
+
+#define WINDOWS_PER_KIND      200
+
+unsigned long calcVariance(int mean);
+
+enum {
+  KIND_STILL,       // one reading with a little noise
+  KIND_NOISY,       // +-20 counts
+  KIND_RANDOM,      // anything
+  KIND_SATURATED,   // pinned at 0 or 255
+  KIND_SWINGS,      // whole window flipping between extremes
+  NUM_KINDS
+};
+static const char *kindNames[NUM_KINDS] = {"still", "noisy", "random", "saturated", "swings"};
+
+// The readings the next HAL_ADC_getScan hands back
+static UINT8 nextX, nextY, nextZ;
+
+void HAL_ADC_init(UINT8 pinEnable, UINT8 control, const UINT8 *channels, UINT8 numChannels)
+{
+  (void)pinEnable; (void)control; (void)channels; (void)numChannels;
+}
+
+BOOL HAL_ADC_startScan(void)
+{
+  return TRUE;
+}
+
+BOOL HAL_ADC_getScan(t_AdcScan *scan)
+{
+  scan->value[ACC_AXIS_X] = nextX;
+  scan->value[ACC_AXIS_Y] = nextY;
+  scan->value[ACC_AXIS_Z] = nextZ;
+  return TRUE;
+}
+
+static UINT8 clampReading(int value)
+{
+  return (UINT8)((value < 0) ? 0 : (value > 255) ? 255 : value);
+}
+
+static UINT8 reading(int kind, int base, int i)
+{
+  switch (kind) {
+  case KIND_STILL:
+    return clampReading(base + rand() % 3 - 1);
+  case KIND_NOISY:
+    return clampReading(base + rand() % 41 - 20);
+  case KIND_RANDOM:
+    return (UINT8)(rand() & 0xFF);
+  case KIND_SATURATED:
+    return (rand() & 1) ? 255 : 0;
+  default:
+    return (i & 1) ? 255 : (UINT8)(rand() % 8);
+  }
+}
+
+// The old calcVariance() loop.  int16 does the math in a 16 bit int
+// like the HCS08, vSquare = vInt * vInt wrapped and sign extended.
+static unsigned long oldVariance(const tIntegratedSample *samples, int n, int mean, BOOL int16)
+{
+  unsigned long vSquare, vSquareTotal=0;
+  int i, variance;
+
+  for (i=0; i<n; i++) {
+    variance = abs(samples[i] - mean);
+    if (int16) {
+      vSquare = (unsigned long)(long)(INT16)(variance * variance);
+    } else {
+      vSquare = variance * variance;
+    }
+    vSquareTotal += vSquare;
+  }
+
+  return isqrt(vSquareTotal / n);
+}
+
+static void runWindows(short windowSize)
+{
+  static tIntegratedSample samples[ACC_SAMPLES_PER_SECOND_FAST];
+  unsigned long got, old32, old16;
+  long sum;
+  int  kind, w, i, base, mean, differ, decisionsDiffer;
+
+  for (kind=0; kind<NUM_KINDS; kind++) {
+    differ = decisionsDiffer = 0;
+
+    for (w=0; w<WINDOWS_PER_KIND; w++) {
+      movementInit(windowSize);
+      base = rand() & 0xFF;
+      sum = 0;
+
+      for (i=0; i<windowSize; i++) {
+        nextX = reading(kind, base, i);
+        nextY = reading(kind, base, i);
+        nextZ = reading(kind, base, i);
+        movementSample();
+
+        samples[i] = getMin(vectorMagnitude(nextX, nextY, nextZ), 441);
+        sum += samples[i];
+      }
+
+      mean = (int)(sum / windowSize);
+      got = calcVariance(mean);
+      old32 = oldVariance(samples, windowSize, mean, FALSE);
+      old16 = oldVariance(samples, windowSize, mean, TRUE);
+
+      TEST_CHECK(got == old32, "running sums don't match the old loop");
+      TEST_CHECK(movementDetected() == (got > NO_MOVEMENT_DEVIATION), "movementDetected disagrees");
+      if (got != old16) {
+        differ++;
+        if ((got > NO_MOVEMENT_DEVIATION) != (old16 > NO_MOVEMENT_DEVIATION)) {
+          decisionsDiffer++;
+        }
+      }
+    }
+
+    printf("window %3d %-9s  matches 32 bit loop, differs from the 16 bit board in %3d of %d"
+           " (movement call changed in %d)\n", windowSize, kindNames[kind], differ,
+           WINDOWS_PER_KIND, decisionsDiffer);
+  }
+}
+
+int main(void)
+{
+  srand(1);
+  ACC_MovementInit();
+
+  runWindows(ACC_SAMPLES_PER_SECOND_SLOW);
+  runWindows(ACC_SAMPLES_PER_SECOND_FAST);
+
+  return TEST_DONE();
+}
@@ -1,44 +1,59 @@
-#ifndef _EVENT_H
-#define _EVENT_H
-
-#include "common_def.h"
-
-// Events that can occur in this system
-typedef enum {
-  NIL_EVENT,
-  SYSTEM_INIT,
-  MVMT_SAMPLE_READY, // a movement sample is ready
-  TIMER_EXPIRED,     // timer has popped
-  MVMT_OCCURED,      // movement has been detected
-  ACK_RECEIVED,      // RF Ack received
-  ACK_TIMEOUT,       // RF Ack timed out
-  KB_PRESS,           // a KB press has occured
-  KB_EVENT,          // debounce finished, process kb now
-  IDLE_LOOP_WAIT,    // go into low power mode
-  MAX_EVENTS
-} t_EventId;
-
-#define MAX_EVENT_DATASIZE 10
-
-// Cross application data block (i.e. global data)
-typedef struct {
-  volatile UINT8 identifier;
-  volatile BOOL  waitingForAck;
-  volatile BOOL  ackReceived;
-  volatile BOOL  s1Pressed;
-  volatile BOOL  s2Pressed;
-} t_CADB;
-
-
-// Event data structure
-typedef struct {
-  t_EventId eventId;
-  short     timerId;    // allows states to get specific timer pops
-
-  char      data[MAX_EVENT_DATASIZE];
-
-  // global data used by all applications
-  t_CADB    *pCADB;
-} t_Event;
-
+#ifndef _EVENT_H
+#define _EVENT_H
+
+#include "common_def.h"
+
+// Events that can occur in this system
+typedef enum {
+  NIL_EVENT,
+  SYSTEM_INIT,
+  MVMT_SAMPLE_READY, // a movement sample is ready
+  TIMER_EXPIRED,     // timer has popped
+  MVMT_OCCURED,      // movement has been detected
+  ACK_RECEIVED,      // RF Ack received
+  ACK_TIMEOUT,       // RF Ack timed out
+  KB_PRESS,           // a KB press has occured
+  KB_EVENT,          // debounce finished, process kb now
+  IDLE_LOOP_WAIT,    // go into low power mode
+  MAX_EVENTS
+} t_EventId;
+
+#define MAX_EVENT_DATASIZE 10
+
+// Cross application data block (i.e. global data)
+typedef struct {
+  volatile UINT8 identifier;
+  volatile BOOL  waitingForAck;
+  volatile BOOL  ackReceived;
+  volatile BOOL  s1Pressed;
+  volatile BOOL  s2Pressed;
+} t_CADB;
+
+
+// Event data structure
+typedef struct {
+  t_EventId eventId;
+  short     timerId;    // allows states to get specific timer pops
+
+  char      data[MAX_EVENT_DATASIZE];
+
+  // global data used by all applications
+  t_CADB    *pCADB;
+} t_Event;
+
+// Events waiting to be handled are kept in a small queue in order of
+// priority (see main.c), first in first out within a priority.  
+// Interrupts, timers and the states post to it, the main loop hands
+// at most EVENT_BUDGET to the state machine each time through so 
+// sampling keeps its rate.  When the queue is full a new event 
+// bumps the newest one of lower priority, if there is one.
+#define EVENT_QUEUE_SIZE   8
+#define EVENT_BUDGET       4
+
+BOOL postEvent(t_EventId eventId, short timerId);
+BOOL getEvent(t_Event *event);
+void cancelEvent(t_EventId eventId, short timerId);
+BOOL eventsPending(void);
+void getEventStats(UINT16 *drops, UINT8 *maxDepth);
+
 #endif
\ No newline at end of file
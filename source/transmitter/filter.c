@@ -0,0 +1,123 @@
+/****************************************************************************
+* filter.c
+*
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	filter.c
+*
+* Fixed point decimating filter for the accelerometer sample stream.
+* Each axis goes through a CIC (cascaded integrator comb) decimator and
+* an optional one pole IIR.  A first order CIC is the same as adding up
+* R samples and dividing by R, but it is built from adds and subtracts
+* only, so higher orders cost almost nothing extra.  See filter.h for
+* the compile time settings.
+*
+****************************************************************************/
+#include "filter.h"
+
+/****************************************************************************
+ * filterInit
+ *
+ * Description: Clears the filter state.  Call before the first sample
+ *              and any time the sample stream is restarted.
+ *
+ * Parms:       filter - filter to initialize
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void filterInit(t_Filter *filter)
+{
+  UINT8 i, stage;
+
+  for (i=0; i<FILTER_NUM_AXES; i++) {
+    for (stage=0; stage<FILTER_CIC_ORDER; stage++) {
+      filter->axis[i].integrator[stage] = 0;
+      filter->axis[i].comb[stage] = 0;
+    }
+    filter->axis[i].iir = 0;
+  }
+
+  filter->sampleCount = 0;
+
+  // A CIC of order N needs N outputs before every comb has seen
+  // a full window.  The ones before that are thrown away, the
+  // last one also starts the IIR.
+  filter->primeCount = FILTER_CIC_ORDER;
+}
+
+/****************************************************************************
+ * filterSample
+ *
+ * Description: Adds one sample for each axis.  Every FILTER_DECIMATION
+ *              samples a filtered value is produced for each axis.
+ *
+ * Parms:       filter - filter state
+ *              in     - FILTER_NUM_AXES new samples
+ *              out    - FILTER_NUM_AXES filtered samples, only valid
+ *                       when TRUE is returned
+ *
+ * Returns:     TRUE if out was written
+ ***************************************************************************/
+BOOL filterSample(t_Filter *filter, const UINT8 *in, UINT8 *out)
+{
+  t_FilterAxis *axis;
+  UINT16 value, delayed;
+#if FILTER_IIR_SHIFT > 0
+  INT16  diff;
+#endif
+  UINT8  i, stage;
+  BOOL   ready;
+
+  filter->sampleCount++;
+  ready = (filter->sampleCount >= FILTER_DECIMATION);
+
+  for (i=0; i<FILTER_NUM_AXES; i++) {
+    axis = &filter->axis[i];
+
+    // Integrators run at the input rate.  They wrap, but the
+    // combs subtract the wrap back out.
+    value = in[i];
+    for (stage=0; stage<FILTER_CIC_ORDER; stage++) {
+      axis->integrator[stage] += value;
+      value = axis->integrator[stage];
+    }
+
+    if (!ready) {
+      continue;
+    }
+
+    // Combs run at the output rate
+    for (stage=0; stage<FILTER_CIC_ORDER; stage++) {
+      delayed = axis->comb[stage];
+      axis->comb[stage] = value;
+      value -= delayed;
+    }
+
+    // remove the CIC gain of R^N
+    value >>= (FILTER_CIC_ORDER * FILTER_DECIMATION_SHIFT);
+
+#if FILTER_IIR_SHIFT > 0
+    if (filter->primeCount > 0) {
+      // start the IIR where the signal is, not at 0
+      axis->iir = (INT16)(value << FILTER_IIR_FRACTION);
+    } else {
+      diff = (INT16)(value << FILTER_IIR_FRACTION) - axis->iir;
+      axis->iir += diff >> FILTER_IIR_SHIFT;
+    }
+    value = (axis->iir + (1 << (FILTER_IIR_FRACTION - 1))) >> FILTER_IIR_FRACTION;
+#endif
+
+    out[i] = (UINT8)value;
+  }
+
+  if (!ready) {
+    return FALSE;
+  }
+
+  filter->sampleCount = 0;
+
+  if (filter->primeCount > 0) {
+    filter->primeCount--;
+  }
+
+  return (filter->primeCount == 0);
+}
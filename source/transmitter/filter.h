@@ -0,0 +1,83 @@
+#ifndef _FILTER_H
+#define _FILTER_H
+
+#include "common_def.h"
+#include "pub_def.h"
+
+// Number of axes run through the filter together
+#define FILTER_NUM_AXES           3
+
+// ******************************************
+// FILTER CONFIGURATION
+// ******************************************
+// The run state samples every 4ms.  The samples are decimated by
+// a CIC filter, then optionally smoothed by a one pole IIR.  All
+// of these are a trade between noise and lag, so pick them here
+// rather than in the state machine.  Each can also be set on the
+// compiler command line, test/test_filter.c measures them.
+#define FILTER_SAMPLE_MS          4
+
+// Decimation ratio R = 2^FILTER_DECIMATION_SHIFT input samples
+// per output sample.
+#ifndef FILTER_DECIMATION_SHIFT
+#define FILTER_DECIMATION_SHIFT   3
+#endif
+#define FILTER_DECIMATION         (1 << FILTER_DECIMATION_SHIFT)
+
+// CIC order.  1 is a plain R sample moving average (the old box
+// filter), 2 is a triangle window over 2R samples that rejects
+// noise much better but has twice the lag.
+#ifndef FILTER_CIC_ORDER
+#define FILTER_CIC_ORDER          1
+#endif
+
+// One pole IIR after decimation, y += (x - y) / 2^FILTER_IIR_SHIFT.
+// 0 turns it off.
+#ifndef FILTER_IIR_SHIFT
+#define FILTER_IIR_SHIFT          0
+#endif
+
+// Group delay in half input samples: (R-1)/2 samples per CIC stage,
+// which is often a half, plus 2^k-1 output samples for the IIR.
+#define FILTER_CIC_DELAY_HALVES   (FILTER_CIC_ORDER * (FILTER_DECIMATION - 1))
+#define FILTER_IIR_DELAY_HALVES   (2 * ((1 << FILTER_IIR_SHIFT) - 1) * FILTER_DECIMATION)
+#define FILTER_GROUP_DELAY_HALVES (FILTER_CIC_DELAY_HALVES + FILTER_IIR_DELAY_HALVES)
+#define FILTER_GROUP_DELAY_MS     ((FILTER_GROUP_DELAY_HALVES * FILTER_SAMPLE_MS) / 2)
+
+// Most lag the wah can take before it feels sluggish.  The build
+// fails rather than quietly shipping a filter that is too slow.
+#define FILTER_MAX_GROUP_DELAY_MS 40
+
+#if FILTER_GROUP_DELAY_MS > FILTER_MAX_GROUP_DELAY_MS
+#error "Filter group delay is over FILTER_MAX_GROUP_DELAY_MS"
+#endif
+
+// The CIC works in 16 bit modulo math, the gain R^N times an
+// 8 bit sample has to fit.
+#if FILTER_CIC_ORDER < 1 || FILTER_CIC_ORDER * FILTER_DECIMATION_SHIFT > 8
+#error "FILTER_CIC_ORDER * FILTER_DECIMATION_SHIFT must be 1-8"
+#endif
+
+// Fraction bits kept in the IIR state
+#define FILTER_IIR_FRACTION       7
+
+// ******************************************
+// END FILTER CONFIGURATION
+// ******************************************
+
+typedef struct {
+  UINT16 integrator[FILTER_CIC_ORDER];
+  UINT16 comb[FILTER_CIC_ORDER];      // last input to each comb stage
+  INT16  iir;                         // FILTER_IIR_FRACTION fixed point
+} t_FilterAxis;
+
+typedef struct {
+  t_FilterAxis axis[FILTER_NUM_AXES];
+  UINT8 sampleCount;                  // input samples this output
+  UINT8 primeCount;                   // outputs until CIC is full
+} t_Filter;
+
+void filterInit(t_Filter *filter);
+BOOL filterSample(t_Filter *filter, const UINT8 *in, UINT8 *out);
+
+#endif
@@ -1,217 +1,395 @@
-/****************************************************************************
-* main.c
-* 
-* Author: Bill Bishop - Sixth Sensor
-* Title: 	main.c
-* 
-* This is the main file for the Remote Control Wah Pedal Transmitter.
-* The transmitter is strapped to the foot of the musician and transmits
-* accelerometer readings to the receiver which controls the wah pedal.
-*
-* This file contains the main loop and state machine/event driver.  It
-* also contains the timeout functions.
-*
-****************************************************************************/
-#include <hidef.h> 
-#include <MC9S08GT60.h> 
-#include "simple_mac.h"
-#include "mcu_hw_config.h"
-#include "MC13192_hw_config.h"
-#include "SCI.h"
-#include "drivers.h"
-#include "sard_board.h"
-#include "HAL.h"
-#include "accelerometer.h"
-#include "net.h"
-#include "timer.h"
-#include "statemach.h"
-
-// Global data used by all applications
-// Cross-application data block
-volatile t_CADB GlobalData;
-
-void main(void) 
-{
-  t_AppStates appState=IDLE_STATE;
-
-  // Create event object
-  t_Event event;
-  memset(&GlobalData, '\0', sizeof(GlobalData));
-  event.pCADB = &GlobalData;
-
-  // Init RF and MCU hardware
-  HAL_RF_init();
-  HAL_MCU_init();
-
-  // Initialize accelerometers and movement sensor system 
-  ACC_init();
-  ACC_MovementInit();
-
-  // Initialize state machine  
-  event.eventId = SYSTEM_INIT;    
-  appState = stMachHandlers[IDLE_STATE](&event);
-
-  for (;;) {
-    // *******************************************************
-    // Low power handling    
-    // To achieve lowest power setting we don't want to
-    // continuously process, so we'll create a sleep event
-    // each time through the loop.  The state machine can
-    // determine how to handle low power mode because it
-    // may be state specific.
-    // *******************************************************
-
-    // This event must be handled by each state and must return
-    // an event to process - or NIL_EVENT if nothing to process
-    event.eventId = IDLE_LOOP_WAIT;    
-    appState = stMachHandlers[appState](&event);
-    // End Low Power handling
-
-    // ********************************************************
-    // Increment timers, don't process timeouts if movement
-    // sample is ready, just increment timers.  We'll get back
-    // to expired timers after checking for movement.    
-    // ********************************************************
-    handleLoopTimer(&event, event.eventId != MVMT_SAMPLE_READY);  
-
-    // ********************************************************
-    // Send the event to the state machine
-    // ********************************************************
-    appState = stMachHandlers[appState](&event);
-  }
-}
-
-/**************************************************************
- * TIMER PROCEDURES
- *
- * The timer procedures are responsible for setting the 
- * appropriate event to be processed.  In general a TIMER_EXPIRED
- * message with timerId set to the specific timer will be set
- * in the event data. The application is then responsible for
- * determining if a timeout occured and how to handle the timeout.
- * The applicaiton is also responsible for restarting timers if
- * needed.
- *
- **************************************************************/
-
-/*********************************************************
- * Called when READY_FLASH_TIMER expires.  This allows the
- * ready mode LED to flash.
- *********************************************************/
-int readyFlashTimer(t_Event *event)
-{
-  event->eventId=TIMER_EXPIRED;
-  event->timerId=READY_FLASH_TIMER;
-  return 0;
-}
-
-/*********************************************************
- * Called when ACK_WAIT_TIMER timer expires.  When this
- * timer expires the receiver did not respond to keep
- * alive message in time. 
- *********************************************************/
-int ackWaitTimer(t_Event *event)
-{
-  // ack wait timer popped, poll the status of the ack
-  if (event->pCADB->ackReceived) {
-    event->eventId=ACK_RECEIVED;
-    event->pCADB->ackReceived=FALSE;
-  } else {
-    event->eventId=TIMER_EXPIRED;
-    event->timerId=ACK_WAIT_TIMER;
-  }
-  return 0;
-}
-
-/*********************************************************
- * Called when KEEPALIVE_SEND_TIMER expires.  When this 
- * timer expires it's time to send the keepalive message
- * to the receiver.
- *********************************************************/
-int keepAliveTimer(t_Event *event)
-{
-  event->eventId=TIMER_EXPIRED;
-  event->timerId=KEEPALIVE_SEND_TIMER;
-  return 0;
-}
-
-/*********************************************************
- * Called when IDLE_TIMER expires.  When this 
- * timer expires the system has been motionless for a while
- * so transition to idle mode.
- *********************************************************/
-int idleTimer(t_Event *event)
-{
-  event->eventId=TIMER_EXPIRED;
-  event->timerId=IDLE_TIMER;
-  return 0;
-}
-
-/*********************************************************
- * Called when debounce timer expires.
- *********************************************************/
-int kbDebounceTimer(t_Event *event)
-{
-  HAL_KB_clear();
-  event->eventId=KB_EVENT;
-  return 0;
-}
-
-/*********************************************************
- * Called when GESTURE_DEBOUNCE_TIMER expires.  When this 
- * timer expires it's time to start looking for gestures
- * via accelerometer.  The gestures turn the system on/off.
- * The debounce timer is used to allow the accelerometers
- * to settle down after a jolt is detected before looking
- * for gestures.
- *********************************************************/
-int gestureDebounceTimer(t_Event *event)
-{
-  event->eventId=TIMER_EXPIRED;
-  event->timerId=GESTURE_DEBOUNCE_TIMER;
-  return 0;
-}
-
-/*********************************************************
- * Called when kb poll timer expires.  Polls for kb press.
- *********************************************************/
-int kbPollTimer(t_Event *event) 
-{
-  event->eventId=NIL_EVENT;
-
-  if (HAL_KB_poll_s1()) {
-    event->eventId=KB_PRESS;
-    event->pCADB->s1Pressed = TRUE;  
-  }
-
-  if (HAL_KB_poll_s2()) {
-    event->eventId=KB_PRESS;
-    event->pCADB->s2Pressed = TRUE;  
-  }
-  return 0;
-}
-
-
-/*********************************************************
- * Turns on/off the RF Problem LED
- *********************************************************/
-void alarmRFProblem(BOOL on_off)
-{
-  LED1 = on_off == TRUE ? LED_ON : LED_OFF;
-}
-
-/*********************************************************
- * Turns on/off the RUN Mode LED
- *********************************************************/
-void runLed(BOOL on_off)
-{
-  LED2 = on_off == TRUE ? LED_ON : LED_OFF;
-}
-
-/*********************************************************
- * Flashes the ready LED
- *********************************************************/
-void readyLedFlash()
-{
-  LED2^=1;
-}
+/****************************************************************************
+* main.c
+* 
+* Author: Bill Bishop - Sixth Sensor
+* Title: 	main.c
+* 
+* This is the main file for the Remote Control Wah Pedal Transmitter.
+* The transmitter is strapped to the foot of the musician and transmits
+* accelerometer readings to the receiver which controls the wah pedal.
+*
+* This file contains the main loop and state machine/event driver.  It
+* also contains the timeout functions.
+*
+****************************************************************************/
+#include <hidef.h> 
+#include <MC9S08GT60.h> 
+#include "simple_mac.h"
+#include "mcu_hw_config.h"
+#include "MC13192_hw_config.h"
+#include "SCI.h"
+#include "drivers.h"
+#include "sard_board.h"
+#include "HAL.h"
+#include "accelerometer.h"
+#include "net.h"
+#include "timer.h"
+#include "statemach.h"
+
+// The host simulation (sim/sim.c) has its own main and calls this one
+#ifdef HOST_SIM
+#define main txMain
+#endif
+
+// Global data used by all applications
+// Cross-application data block
+volatile t_CADB GlobalData;
+
+// Event queue.  Interrupts are masked while it changes so interrupts
+// can post too.
+typedef struct {
+  t_EventId eventId;
+  short     timerId;
+} t_QueuedEvent;
+
+static t_QueuedEvent eventQueue[EVENT_QUEUE_SIZE];  // highest priority first
+static volatile UINT8 eventCount=0;
+static UINT8  eventCcr;
+static UINT16 eventDrops=0;           // events lost to a full queue
+static UINT8  eventMaxDepth=0;
+
+// Priority of each event, 0 goes first.  Motion comes before 
+// everything, it is what the musician hears.
+static const UINT8 eventPriority[MAX_EVENTS] = {
+  3,  // NIL_EVENT
+  0,  // SYSTEM_INIT
+  0,  // MVMT_SAMPLE_READY
+  2,  // TIMER_EXPIRED
+  0,  // MVMT_OCCURED
+  1,  // ACK_RECEIVED
+  1,  // ACK_TIMEOUT
+  3,  // KB_PRESS
+  3,  // KB_EVENT
+  3   // IDLE_LOOP_WAIT
+};
+
+void main(void) 
+{
+  t_AppStates appState=IDLE_STATE;
+  UINT8 budget;
+
+  // Create event object
+  t_Event event;
+  memset((void *)&GlobalData, '\0', sizeof(GlobalData));
+  event.pCADB = (t_CADB *)&GlobalData;
+
+  // Init RF and MCU hardware
+  HAL_RF_init();
+  HAL_MCU_init();
+
+  // Initialize accelerometers and movement sensor system 
+  ACC_init();
+  ACC_MovementInit();
+
+  // Initialize state machine  
+  event.eventId = SYSTEM_INIT;    
+  appState = stMachDispatch(IDLE_STATE, &event);
+
+  for (;;) {
+    // *******************************************************
+    // Low power handling    
+    // To achieve lowest power setting we don't want to
+    // continuously process, so we'll create a sleep event
+    // each time through the loop.  The state machine can
+    // determine how to handle low power mode because it
+    // may be state specific.
+    // *******************************************************
+
+    // This event must be handled by each state and must return
+    // an event to process - or NIL_EVENT if nothing to process.
+    // The state sleeps until the next sample or timer deadline,
+    // there is no fixed loop rate.
+    event.eventId = IDLE_LOOP_WAIT;    
+    appState = stMachDispatch(appState, &event);
+    if (event.eventId != NIL_EVENT) {
+      postEvent(event.eventId, event.timerId);
+    }
+    // End Low Power handling
+
+    // ********************************************************
+    // Post every expired timer.  A movement sample ready is
+    // still handled first, it has the higher priority.
+    // ********************************************************
+    handleLoopTimer(&event);
+
+    // ********************************************************
+    // Send the events to the state machine, most important
+    // first.  Any left over wait for the next time through.
+    // ********************************************************
+    for (budget=0; budget<EVENT_BUDGET && getEvent(&event); budget++) {
+      appState = stMachDispatch(appState, &event);
+    }
+  }
+}
+
+/****************************************************************************
+ * postEvent
+ *
+ * Description: Queues an event for the state machine.  Safe to call 
+ *              from an interrupt.
+ *
+ * Parms:       eventId - event
+ *              timerId - timer, for TIMER_EXPIRED
+ *
+ * Returns:     FALSE if the queue was full of more important events
+ ***************************************************************************/
+BOOL postEvent(t_EventId eventId, short timerId)
+{
+  UINT8 priority, i;
+  BOOL  posted = TRUE;
+
+  if (eventId >= MAX_EVENTS) {
+    return FALSE;
+  }
+  priority = eventPriority[eventId];
+
+  CRITICAL_ENTER(eventCcr);
+
+  if (eventCount == EVENT_QUEUE_SIZE) {
+    // make room by dropping the newest, least important one
+    eventDrops++;
+    if (priority < eventPriority[eventQueue[EVENT_QUEUE_SIZE-1].eventId]) {
+      eventCount--;
+    } else {
+      posted = FALSE;
+    }
+  }
+
+  if (posted) {
+    // behind everything of the same priority or higher
+    for (i=eventCount; i>0 && eventPriority[eventQueue[i-1].eventId] > priority; i--) {
+      eventQueue[i] = eventQueue[i-1];
+    }
+    eventQueue[i].eventId = eventId;
+    eventQueue[i].timerId = timerId;
+    eventCount++;
+    if (eventCount > eventMaxDepth) {
+      eventMaxDepth = eventCount;
+    }
+  }
+
+  CRITICAL_EXIT(eventCcr);
+  return posted;
+}
+
+/****************************************************************************
+ * getEvent
+ *
+ * Description: Takes the most important event off the queue.
+ *
+ * Parms:       event - eventId and timerId filled in
+ *
+ * Returns:     FALSE if the queue was empty
+ ***************************************************************************/
+BOOL getEvent(t_Event *event)
+{
+  UINT8 i;
+
+  if (eventCount == 0) {
+    return FALSE;
+  }
+
+  CRITICAL_ENTER(eventCcr);
+  event->eventId = eventQueue[0].eventId;
+  event->timerId = eventQueue[0].timerId;
+  eventCount--;
+  for (i=0; i<eventCount; i++) {
+    eventQueue[i] = eventQueue[i+1];
+  }
+  CRITICAL_EXIT(eventCcr);
+
+  return TRUE;
+}
+
+/****************************************************************************
+ * cancelEvent
+ *
+ * Description: Takes an event back off the queue, so a timer that is
+ *              stopped after it expired isn't handled.
+ *
+ * Parms:       eventId - event
+ *              timerId - timer, for TIMER_EXPIRED
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void cancelEvent(t_EventId eventId, short timerId)
+{
+  UINT8 i, kept;
+
+  CRITICAL_ENTER(eventCcr);
+  for (i=0, kept=0; i<eventCount; i++) {
+    if (eventQueue[i].eventId != eventId || eventQueue[i].timerId != timerId) {
+      eventQueue[kept++] = eventQueue[i];
+    }
+  }
+  eventCount = kept;
+  CRITICAL_EXIT(eventCcr);
+}
+
+/****************************************************************************
+ * eventsPending
+ *
+ * Description: Tells the low power handler not to sleep
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if there are events waiting
+ ***************************************************************************/
+BOOL eventsPending(void)
+{
+  return (eventCount != 0);
+}
+
+/****************************************************************************
+ * getEventStats
+ *
+ * Description: Event queue statistics, for looking at in the debugger
+ *
+ * Parms:       drops    - events lost to a full queue
+ *              maxDepth - most events ever waiting
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void getEventStats(UINT16 *drops, UINT8 *maxDepth)
+{
+  *drops = eventDrops;
+  *maxDepth = eventMaxDepth;
+}
+
+/**************************************************************
+ * TIMER PROCEDURES
+ *
+ * The timer procedures are responsible for setting the 
+ * appropriate event to be processed, handleLoopTimer posts
+ * it to the event queue.  In general a TIMER_EXPIRED
+ * message with timerId set to the specific timer will be set
+ * in the event data. The application is then responsible for
+ * determining if a timeout occured and how to handle the timeout.
+ * The applicaiton is also responsible for restarting timers if
+ * needed.
+ *
+ **************************************************************/
+
+/*********************************************************
+ * Called when READY_FLASH_TIMER expires.  This allows the
+ * ready mode LED to flash.
+ *********************************************************/
+int readyFlashTimer(t_Event *event)
+{
+  event->eventId=TIMER_EXPIRED;
+  event->timerId=READY_FLASH_TIMER;
+  return 0;
+}
+
+/*********************************************************
+ * Called when ACK_WAIT_TIMER timer expires.  When this
+ * timer expires the receiver did not respond to keep
+ * alive message in time. 
+ *********************************************************/
+int ackWaitTimer(t_Event *event)
+{
+  // ack wait timer popped, poll the status of the ack.
+  // Normally the ack was posted when it came in, the flag
+  // is only set if the queue was full.
+  if (event->pCADB->ackReceived) {
+    event->eventId=ACK_RECEIVED;
+    event->pCADB->ackReceived=FALSE;
+  } else {
+    event->eventId=TIMER_EXPIRED;
+    event->timerId=ACK_WAIT_TIMER;
+  }
+  return 0;
+}
+
+/*********************************************************
+ * Called when KEEPALIVE_SEND_TIMER expires.  When this 
+ * timer expires it's time to send the keepalive message
+ * to the receiver.
+ *********************************************************/
+int keepAliveTimer(t_Event *event)
+{
+  event->eventId=TIMER_EXPIRED;
+  event->timerId=KEEPALIVE_SEND_TIMER;
+  return 0;
+}
+
+/*********************************************************
+ * Called when IDLE_TIMER expires.  When this 
+ * timer expires the system has been motionless for a while
+ * so transition to idle mode.
+ *********************************************************/
+int idleTimer(t_Event *event)
+{
+  event->eventId=TIMER_EXPIRED;
+  event->timerId=IDLE_TIMER;
+  return 0;
+}
+
+/*********************************************************
+ * Called when debounce timer expires.
+ *********************************************************/
+int kbDebounceTimer(t_Event *event)
+{
+  HAL_KB_clear();
+  event->eventId=KB_EVENT;
+  return 0;
+}
+
+/*********************************************************
+ * Called when GESTURE_DEBOUNCE_TIMER expires.  When this 
+ * timer expires it's time to start looking for gestures
+ * via accelerometer.  The gestures turn the system on/off.
+ * The debounce timer is used to allow the accelerometers
+ * to settle down after a jolt is detected before looking
+ * for gestures.
+ *********************************************************/
+int gestureDebounceTimer(t_Event *event)
+{
+  event->eventId=TIMER_EXPIRED;
+  event->timerId=GESTURE_DEBOUNCE_TIMER;
+  return 0;
+}
+
+/*********************************************************
+ * Called when kb poll timer expires.  Polls for kb press.
+ *********************************************************/
+int kbPollTimer(t_Event *event) 
+{
+  event->eventId=NIL_EVENT;
+
+  if (HAL_KB_poll_s1()) {
+    event->eventId=KB_PRESS;
+    event->pCADB->s1Pressed = TRUE;  
+  }
+
+  if (HAL_KB_poll_s2()) {
+    event->eventId=KB_PRESS;
+    event->pCADB->s2Pressed = TRUE;  
+  }
+  return 0;
+}
+
+
+/*********************************************************
+ * Turns on/off the RF Problem LED
+ *********************************************************/
+void alarmRFProblem(BOOL on_off)
+{
+  LED1 = on_off == TRUE ? LED_ON : LED_OFF;
+}
+
+/*********************************************************
+ * Turns on/off the RUN Mode LED
+ *********************************************************/
+void runLed(BOOL on_off)
+{
+  LED2 = on_off == TRUE ? LED_ON : LED_OFF;
+}
+
+/*********************************************************
+ * Flashes the ready LED
+ *********************************************************/
+void readyLedFlash()
+{
+  LED2^=1;
+}
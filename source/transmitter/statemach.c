@@ -1,588 +1,998 @@
-/****************************************************************************
-* statemach.c
-* 
-* Author: 	Bill Bishop - Sixth Sensor
-* Title: 	statemach.c
-* 
-* This is the state machine for the transmitter.  It is responsible for 
-* handling system events based on the current state of the system. 
-* Currently the following states are defined:
-*
-*
-* Idle state  - initial state after power up, or no movement detected 
-*               for extended period of time. RF is dozed, MCU is
-*               in low power.  Only waking up to detect movement.
-* Ready state - movement has been detected, RF is powered up in idle mode,
-*               RF keepalive is taking place.
-* Run state -   RF is in IDLE or TX mode most of the time and accelerometer
-*               readings are being sent to the receiver on a periodic basis.
-*               When a gesture off is detected, go back to ready state.
-* 
-* State transitions: Idle->Ready->Run->Ready->Idle
-*
-****************************************************************************/
-#include "statemach.h"
-#include "event.h"
-#include "timer.h"
-#include "accelerometer.h"
-#include "HAL.h"
-#include "sard_board.h"
-#include "net.h"
-#include "common_def.h"
-#include <stdtypes.h>
-
-// Do software filtering on accelerometer samples to remove noise.
-// Every 8th sample is averaged to achieve filtering.
-#define RUN_SAMPLE_FILTER_VALUE   8
-
-// Shift 3 for fast divide by 8 - must match value above
-#define RUN_SAMPLE_FILTER_SHIFT   3
-
-// The gesture off acceleration depends on the sample rate
-// so we'll define it in this module.  This is the acceleration
-// of the x axis for the off gesture.
-#define GESTURE_OFF_ACCELERATION  65
-
-// Prototypes for state machine handlers
-t_AppStates idleStateHandler(t_Event *);
-t_AppStates readyStateHandler(t_Event *);
-t_AppStates runStateHandler(t_Event *);
-
-// Entry procs for each state
-t_AppStates idleStateEnter(t_Event *pEvent);
-t_AppStates readyStateEnter(t_Event *pEvent);
-t_AppStates runStateEnter(t_Event *pEvent);
-
-// State machine handlers
-t_stMachFuncPtr stMachHandlers[MAX_STATES] = 
-{ &idleStateHandler, 
-  &readyStateHandler,
-  &runStateHandler};
-
-// Prototypes for doing work in this module  
-void                lowPowerHandler(UINT8 nDozeValue, int nDozeMs, BOOL timerOn);
-t_NetCallback       netCallback(t_NetData data);
-extern volatile     t_CADB GlobalData;
-void processKBEvent (t_Event *pEvent, int *handled);
-
-// Packet used to send data to receiver
-static t_NetPacket packet;
-
-// Globals needed for run state
-static int sampleNum,avgX,avgY,avgZ;
-static BOOL gestureOffDetect;
-
-/****************************************************************************
- * commonStateHandler
- *
- * Description: Handles events that are common to all states.
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     True if the event was handled, false if not. 
- ***************************************************************************/
-static int commonStateHandler(t_Event *pEvent)
-{
-  int handled=0;
-
-  switch (pEvent->eventId) {
-  case ACK_RECEIVED:
-    // Clear any alarms, we got an ack!
-    alarmRFProblem(FALSE);
-
-    // Stop the timer
-    stopTimer(ACK_WAIT_TIMER);
-    break;
-
-  case KB_PRESS:
-    // When keyboard debounce timer pops then we'll process
-    // the keyboard press.
-    //
-    // Start the debounce timer
-    startTimer(KB_DEBOUNCE_TIMER, FALSE);
-    handled = 1;
-    break;
-
-  case KB_EVENT:
-    // Debounce timer expired
-    processKBEvent(pEvent, &handled);
-    break;
-
-  case TIMER_EXPIRED:
-    {
-      switch (pEvent->timerId) {
-      case ACK_WAIT_TIMER:
-        // Generate RF alarm
-        alarmRFProblem(TRUE);
-        break;
-
-        // time to send another packet to receiver
-      case KEEPALIVE_SEND_TIMER:
-        // Always send a packet to the receiver regardless
-        // of the alarm status. This allows the detector and
-        // receiver to generate LED status if they are not
-        // in range of each other - or if channel is not
-        // configured properly.
-
-        // clear ack received flag
-        pEvent->pCADB->ackReceived = FALSE;
-
-        if (!sendRFMessage(KEEPALIVE)) {
-          alarmRFProblem(TRUE);
-        } else {
-          // Turn on receiver and set ack timer
-          rcvRFData(netCallback);
-          startTimer(ACK_WAIT_TIMER, FALSE);
-        }
-        break;
-      }// timerid
-      break;
-    }// timer expired
-    break;
-  }
-
-  return handled;  
-}
-
-/****************************************************************************
- * idleStateEnter
- *
- * Description: Setup for the idle state.
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     IDLE_STATE 
- ***************************************************************************/
-t_AppStates idleStateEnter(t_Event *pEvent)
-{
-  // Initialize the movement system, not sampling too fast in this state
-  // because it is not required, and we want to sleep as much as possible.
-  movementInit(ACC_SAMPLES_PER_SECOND_SLOW);
-
-  // No LEDs in idle state  
-  runLed(FALSE);
-  alarmRFProblem(FALSE);
-
-  // Put RF Device into low power mode until we need it
-  HAL_RF_lowpower();
-
-  // The timer loop will get invoked approximately 62 times
-  // per second in this state  
-  setTimerBase(ACC_SAMPLE_FREQUENCY_SLOW);
-
-  // Start polling the keyboard
-  startTimer(KB_POLL_TIMER, TRUE);
-
-  return IDLE_STATE;
-
-}
-
-/****************************************************************************
- * idleStateHandler
- *
- * Description: Idle state processor.
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     next state to enter, or IDLE_STATE if no change. 
- ***************************************************************************/
-t_AppStates idleStateHandler(t_Event *pEvent)
-{
-  t_AppStates state=IDLE_STATE;
-
-  if (commonStateHandler(pEvent)) {
-    return state;
-  }
-
-  switch (pEvent->eventId) {
-  case SYSTEM_INIT:
-    state = idleStateEnter(pEvent);
-    break;
-
-    // Special event that should determine if other events
-    // are to be processed by this state
-  case IDLE_LOOP_WAIT:
-    pEvent->eventId = NIL_EVENT;  
-
-    // **********************************************************
-    // MCU STOP MODE!!!!
-    // **********************************************************
-
-    // Let the MCU sleep to conserve battery life, TRUE means that
-    // we don't want the lowPowerHandler to return until full timeslice
-    // is up.  This will keep our timers in sync.
-    lowPowerHandler(ACC_DOZE_FREQ_SLOW, ACC_SAMPLE_FREQUENCY_SLOW, TRUE);
-
-    // **********************************************************
-    // MCU back from STOP mode.  
-    // **********************************************************
-
-    // Each time through the loop take an accelerometer 
-    // movement reading.  A movement sample requires quite
-    // a bit of processing because of the math involved.
-    if (movementSample()) {
-      // Next time through the loop, process this event
-      pEvent->eventId = MVMT_SAMPLE_READY;
-    }
-    break;
-
-  case MVMT_SAMPLE_READY:
-    // if movement detected transition to ready mode
-    if (movementDetected()) {
-      state = readyStateEnter(pEvent);
-    }
-
-    // reinitialize the movement system for next sample period
-    movementInit(ACC_SAMPLES_PER_SECOND_SLOW);
-    break;
-
-  case NIL_EVENT:
-    break;
-  }
-  return state;
-}
-
-/****************************************************************************
- * readyStateEnter
- *
- * Description: Ready state entry.  In this state the RF is powered up
- *              in IDLE mode, but MCU is still sleeping periodically.
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     READY_STATE
- ***************************************************************************/
-t_AppStates readyStateEnter(t_Event *pEvent)
-{
-  // Initialize the movement system, crank it up to fast mode
-  movementInit(ACC_SAMPLES_PER_SECOND_FAST);
-
-  // Start looking for on gesture
-  gestureInit();
-
-  // Flash LED in ready mode
-  runLed(FALSE);
-  readyLedFlash();
-
-  // The timer loop will get invoked approximately 256 times
-  // per second in this state  
-  setTimerBase(ACC_SAMPLE_FREQUENCY_FAST);
-
-  // Start timer to keep monitoring movement.  We'll transition
-  // back to idle if no movement detected  
-  startTimer(IDLE_TIMER, FALSE);
-  startTimer(KEEPALIVE_SEND_TIMER, TRUE);
-  startTimer(READY_FLASH_TIMER, FALSE);
-  startTimer(KB_POLL_TIMER, TRUE);
-
-  // wake up the RF device, which will take ~ 323uSeconds for 13192. 
-  // we do this because we want instant response once the gesture
-  // to turn on wah pedal is recognized
-  HAL_RF_wake_wait();
-
-  // Make sure receiver knows the pedal is off
-  sendRFMessage(WAH_OFF);
-  return READY_STATE;
-}
-
-/****************************************************************************
- * readyStateHandler
- *
- * Description: Ready state processor.  
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     new state or READY_STATE if no change
- ***************************************************************************/
-t_AppStates readyStateHandler(t_Event *pEvent)
-{
-  t_AppStates state=READY_STATE;
-
-  if (commonStateHandler(pEvent)) {
-    return state;
-  }
-
-  switch (pEvent->eventId) {
-  case NIL_EVENT:
-    break;
-
-    // Special event that should determine if other events
-    // are to be processed by this state
-  case IDLE_LOOP_WAIT:
-    pEvent->eventId = NIL_EVENT;  
-
-    // We are spending all available processing power 
-    // to sample at 256 times per second along with
-    // all of the math involved.  Therefore, in this
-    // mode there is no low power setting.
-
-
-    // In this mode, we are monitoring for WAH-ON gesture.
-    // If we get it, we enter RUN mode.  The WAH-ON gesture
-    // requires movement samples which are math intensive. 
-    // However, we are not monitoring for general movement
-    // so we don't need an entire sample window, just look
-    // at one sample to the next.      
-    //
-    // However, we also need to monitor for general movement
-    // because we need to turn off automatically if no movement
-    // occurs within window.
-    if (movementSample()) {
-      // Next time through the loop, process this event
-      pEvent->eventId = MVMT_SAMPLE_READY;
-    }
-
-    // Determine if gesture ON has occured
-    if (gestureOnDetected()) {
-      state = runStateEnter(pEvent);
-    }
-    break;
-
-  case TIMER_EXPIRED:
-    {
-      switch (pEvent->timerId) {
-      // idle timer
-      case IDLE_TIMER:
-        // when this timer pops, the system has been
-        // motionless for quite some time, transition
-        // back to idle
-        state = idleStateEnter(pEvent);
-        break;
-
-      case READY_FLASH_TIMER:
-        readyLedFlash();
-        startTimer(READY_FLASH_TIMER, FALSE);
-        break;
-
-      }// switch timer id
-
-    }// timer expired event
-    break;
-
-  case MVMT_SAMPLE_READY:
-    // if movement detected remain in this mode
-    if (movementDetected()) {
-      // restart idle timer
-      stopTimer(IDLE_TIMER);
-      startTimer(IDLE_TIMER, FALSE);
-    }
-
-    // reinitialize the movement system
-    movementInit(ACC_SAMPLES_PER_SECOND_FAST);
-    break;
-  }// switch
-
-  return state;
-}
-
-/****************************************************************************
- * runStateEnter
- *
- * Description: run state entry
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     RUN_STATE
- ***************************************************************************/
-t_AppStates runStateEnter(t_Event *pEvent)
-{
-  // Set timer base to the sample frequency in this state
-  setTimerBase(T_4_MS_SAMPLE_RATE);
-
-  // Wait before checking for off gesture 
-  startTimer(GESTURE_DEBOUNCE_TIMER, FALSE);
-
-  // LED to notify user that run mode is entered
-  runLed(TRUE);
-
-  gestureOffDetect = FALSE;
-  gestureInit();
-
-  // Make sure receiver is off (from ack receive), we're going to start
-  // transmitting at this point
-  stopReceive();
-
-  // We use a global here only to allow for easy debugging
-  // mode where we send raw data to receiver
-  strcpy(packet.idString, NET_ID_STRING);
-
-  // Make sure receiver knows the pedal is off
-  sendRFMessage(WAH_ON);
-  sampleNum=avgX=avgY=avgZ=0;
-
-  pEvent->eventId = NIL_EVENT;
-  return RUN_STATE;
-}
-
-/****************************************************************************
- * runStateHandler
- *
- * Description: run state processor
- *
- * Parms:       pEvent - pointer to currently processing event.
- *
- * Returns:     new state or RUN_STATE if no change
- ***************************************************************************/
-t_AppStates runStateHandler(t_Event *pEvent)
-{
-  int state=RUN_STATE;
-  static tAccSample sampleX, sampleZ, sampleY;
-
-  if (commonStateHandler(pEvent)) {
-    return state;
-  }
-
-  switch (pEvent->eventId) {
-  case NIL_EVENT:
-    break;
-
-  case IDLE_LOOP_WAIT:
-
-    // Sample 250 times/second...
-    // sleep MCU for 4 ms, then sample
-    lowPowerHandler(RTI_EXT_DOZE_4_MSEC, 4, TRUE);
-
-    // sample all axes
-    sampleNum++;
-    ACC_read_x(&sampleX);
-    ACC_read_y(&sampleY);
-    ACC_read_z(&sampleZ);
-
-    // remove noise from the sampled data (software filtering)
-    if (sampleNum >= RUN_SAMPLE_FILTER_VALUE) {
-      avgX>>=RUN_SAMPLE_FILTER_SHIFT;
-      avgY>>=RUN_SAMPLE_FILTER_SHIFT;
-      avgZ>>=RUN_SAMPLE_FILTER_SHIFT;
-
-      // Send accelerometer averages to receiver
-      packet.msgType = WAH_MVMT;
-      packet.netData[0] = avgX;
-      packet.netData[1] = avgY;
-      packet.netData[2] = avgZ;
-      if (!sendRFPacket(&packet)) {
-        alarmRFProblem(TRUE);
-      } else {
-        alarmRFProblem(FALSE);
-      }
-
-      // Use averaged X sample to detect off gesture
-      if (gestureOffDetect) {
-        if (gestureOffDetected(avgX, GESTURE_OFF_ACCELERATION)) {
-          state = readyStateEnter(pEvent);
-        }
-      }// if ok to look for off gesture
-
-      // Reset averages        
-      sampleNum=avgX=avgY=avgZ=0;
-    }// if avg sample ready
-    else {
-      // keep running sum of sample values until ready to avg
-      avgX+=sampleX;
-      avgY+=sampleY;
-      avgZ+=sampleZ;
-    }
-
-    pEvent->eventId = NIL_EVENT;      
-    break;
-
-  case TIMER_EXPIRED:
-    {
-      switch (pEvent->timerId) {
-      // idle timer
-      case GESTURE_DEBOUNCE_TIMER:
-        // start checking for gesture off now, if detected
-        // it will take us out of this state
-        gestureOffDetect = TRUE;
-        break;
-      }
-    }
-    break;
-  }
-  return state;
-}
-
-/****************************************************************************
- * processKBEvent
- *
- * Description: handles kb press
- *
- * Parms:       pEvent - pointer to currently processing event, handled.
- *
- * Returns:     nothing
- ***************************************************************************/
-void processKBEvent(t_Event *pEvent, int *handled)
-{
-  if (pEvent->pCADB->s1Pressed) {
-    // selects new RF channel.
-    selectNextRFChannel();
-    *handled=1;
-
-    // don't come back here again until user presses again
-    pEvent->pCADB->s1Pressed = FALSE;
-  }
-}
-
-/****************************************************************************
- * netCallback
- *
- * Description: callback procedure that gets invoked when a packet arrives
- *
- * Parms:       *data - pointer to received packet
- *
- * Returns:     nothing
- ***************************************************************************/
-static t_NetCallback netCallback(t_NetPacket *data)
-{
-  // We got an acknowledgement from receiver, set global
-  // flag
-  if (data->msgType == WAH_ACK) {
-    GlobalData.ackReceived = TRUE;
-  }
-}
-
-
-/****************************************************************************
- * lowPowerHandler
- *
- * Description: The low power handler for the state machine.  Puts the 
- *              MCU into STOP3 mode.  If timerOn=TRUE then this procedure
- *              will not return until the alloted time has elapsed.  This
- *              allows for the timer to continue to run on schedule without
- *              having a separate interrupt for the timer.
- *
- * Parms:       nDozeValue - HAL defined doze value
- *              nDozeMs    - number of MS to doze
- *              timerOn    - if true, delays if STOP exited prematurely
- *
- * Returns:     nothing
- ***************************************************************************/
-void lowPowerHandler(UINT8 nDozeValue, int nDozeMs, BOOL timerOn)
-{
-  static t_time startTime, endTime, asleepMs;
-  static UINT16 delayMs;
-
-  if (timerOn) {
-    // Get current system time (timer ticks)
-    HAL_getTicks(&startTime);
-  }
-
-  // put MCU into stop mode 
-  HAL_MCU_sleep(nDozeValue, FALSE);
-
-  if (timerOn) {
-    // Get current system time (timer ticks)
-    // and determine how long we were in low power sleep
-    // mode.  Eat up any leftover time so that the timer
-    // loop is called at an accurate rate
-    HAL_getTicks(&endTime);
-    HAL_difftime(startTime, endTime, &asleepMs);
-
-    // Eat up any leftover time, the low power wait may
-    // have been interrupted.  By delaying here we keep
-    // the timer loop consistent.    
-    if (asleepMs < nDozeMs) {
-      delayMs = nDozeMs - asleepMs;
-      MCU_delay(delayMs);
-    }
-  }// if timerOn
-}
+/****************************************************************************
+* statemach.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	statemach.c
+* 
+* This is the state machine for the transmitter.  It is responsible for 
+* handling system events based on the current state of the system. 
+* Currently the following states are defined:
+*
+*
+* Idle state  - initial state after power up, or no movement detected 
+*               for extended period of time. RF is dozed, MCU is
+*               in low power.  Only waking up to detect movement.
+* Ready state - movement has been detected, RF is powered up in idle mode,
+*               RF keepalive is taking place.
+* Run state -   RF is in IDLE or TX mode most of the time and accelerometer
+*               readings are being sent to the receiver on a periodic basis.
+*               When a gesture off is detected, go back to ready state.
+* 
+* State transitions: Idle->Ready->Run->Ready->Idle
+*
+* The states are a table of what each state does with each event, and 
+* which state it may go to, see STATE TABLE below.  An event is a single
+* lookup in the table, then an action, exit and entry procs.
+*
+****************************************************************************/
+#include "statemach.h"
+#include "event.h"
+#include "timer.h"
+#include "accelerometer.h"
+#include "HAL.h"
+#include "sard_board.h"
+#include "net.h"
+#include "filter.h"
+#include "fixed_trig.h"
+#include "common_def.h"
+#include <stdtypes.h>
+#ifdef HOST_SIM
+#include "sim.h"
+#endif
+
+// The gesture off acceleration depends on the sample rate
+// so we'll define it in this module.  This is the acceleration
+// of the x axis for the off gesture.
+#define GESTURE_OFF_ACCELERATION  65
+
+// Run state movement packets are only sent when the pedal angle
+// moves more than the hysteresis since the last packet sent, so
+// no airtime is wasted while the foot is still.  A heartbeat
+// packet still goes out every so often to keep the receiver in
+// sync.  The angle is in tenths of a degree, the same as the
+// receiver calculates from the packet.
+#define RUN_TX_HYSTERESIS       3    // ~2 wah pot steps
+#define RUN_TX_HEARTBEAT_MS     500
+#define RUN_TX_HEARTBEAT_COUNT  (RUN_TX_HEARTBEAT_MS / (FILTER_DECIMATION * FILTER_SAMPLE_MS))
+
+// The receiver tosses the first few movement packets after WAH_ON
+// while the accelerometers settle, always send this many.
+#define RUN_TX_STARTUP_PACKETS  4
+
+// Entry and exit actions for each state
+static void idleStateEnter(t_Event *pEvent);
+static void readyStateEnter(t_Event *pEvent);
+static void runStateEnter(t_Event *pEvent);
+static void readyStateExit(t_Event *pEvent);
+static void runStateExit(t_Event *pEvent);
+
+// Transition actions, see the state table
+static BOOL commonAckReceived(t_Event *pEvent);
+static BOOL commonKbPress(t_Event *pEvent);
+static BOOL commonKbEvent(t_Event *pEvent);
+static BOOL commonAckTimeout(t_Event *pEvent);
+static BOOL commonKeepAlive(t_Event *pEvent);
+static BOOL idleLoopWait(t_Event *pEvent);
+static BOOL idleMovement(t_Event *pEvent);
+static BOOL readyLoopWait(t_Event *pEvent);
+static BOOL readyMovement(t_Event *pEvent);
+static BOOL readyFlash(t_Event *pEvent);
+static BOOL runLoopWait(t_Event *pEvent);
+static BOOL runGestureDebounce(t_Event *pEvent);
+
+// ******************************************
+// STATE TABLE
+// ******************************************
+// What each state does with each event.  An expired timer is an
+// event of its own, ST_TIMER(timerId), so timers are looked up the
+// same way as everything else.  Each entry is one of:
+//
+//   ST_NONE             - event is ignored
+//   ST_DO(action)       - action is called, the state doesn't change
+//   ST_IF(action,state) - action is called, if it returns TRUE the 
+//                         state is left and state is entered
+//   ST_GO(state)        - state is always entered
+//
+// Leaving a state calls its exit action, entering one its entry
+// action, even when going back into the same state.  The events 
+// every state handles the same way (acks, keepalives, keyboard)
+// are just repeated in each row.
+typedef BOOL (*t_StAction)(t_Event *);
+typedef void (*t_StEntryExit)(t_Event *);
+
+typedef struct {
+  t_StAction action;     // NULL for none
+  UINT8      next;       // ST_STAY for no state change
+} t_StTransition;
+
+#define ST_STAY               MAX_STATES
+#define ST_TIMER(timerId)     (MAX_EVENTS + (timerId))
+#define ST_NUM_TRIGGERS       (MAX_EVENTS + MAX_TIMERS)
+
+#define ST_NONE               { NULL, ST_STAY }
+#define ST_DO(action)         { &action, ST_STAY }
+#define ST_IF(action, state)  { &action, state }
+#define ST_GO(state)          { NULL, state }
+
+// One state's row, in t_EventId then t_TimerId order.  Naming 
+// every column means a row that is too short or too long doesn't
+// build.
+#define ST_ROW_LENGTH         17
+#define ST_ROW(nilEvent, systemInit, mvmtSampleReady, timerExpired,     \
+               mvmtOccured, ackReceived, ackTimeout, kbPress, kbEvent,  \
+               idleLoopWait, ackWaitTimer, keepAliveTimer, idleTimer,   \
+               kbDebounceTimer, kbPollTimer, readyFlashTimer,           \
+               gestureDebounceTimer)                                    \
+  { nilEvent, systemInit, mvmtSampleReady, timerExpired,                \
+    mvmtOccured, ackReceived, ackTimeout, kbPress, kbEvent,             \
+    idleLoopWait, ackWaitTimer, keepAliveTimer, idleTimer,              \
+    kbDebounceTimer, kbPollTimer, readyFlashTimer,                      \
+    gestureDebounceTimer }
+
+static const t_StTransition stTable[][ST_NUM_TRIGGERS] = {
+  // IDLE_STATE
+  ST_ROW(ST_NONE,                                 // NIL_EVENT
+         ST_GO(IDLE_STATE),                       // SYSTEM_INIT
+         ST_IF(idleMovement, READY_STATE),        // MVMT_SAMPLE_READY
+         ST_NONE,                                 // TIMER_EXPIRED
+         ST_NONE,                                 // MVMT_OCCURED
+         ST_DO(commonAckReceived),                // ACK_RECEIVED
+         ST_NONE,                                 // ACK_TIMEOUT
+         ST_DO(commonKbPress),                    // KB_PRESS
+         ST_DO(commonKbEvent),                    // KB_EVENT
+         ST_DO(idleLoopWait),                     // IDLE_LOOP_WAIT
+         ST_DO(commonAckTimeout),                 // ACK_WAIT_TIMER
+         ST_DO(commonKeepAlive),                  // KEEPALIVE_SEND_TIMER
+         ST_NONE,                                 // IDLE_TIMER
+         ST_NONE,                                 // KB_DEBOUNCE_TIMER
+         ST_NONE,                                 // KB_POLL_TIMER
+         ST_NONE,                                 // READY_FLASH_TIMER
+         ST_NONE),                                // GESTURE_DEBOUNCE_TIMER
+  // READY_STATE
+  ST_ROW(ST_NONE,                                 // NIL_EVENT
+         ST_NONE,                                 // SYSTEM_INIT
+         ST_DO(readyMovement),                    // MVMT_SAMPLE_READY
+         ST_NONE,                                 // TIMER_EXPIRED
+         ST_NONE,                                 // MVMT_OCCURED
+         ST_DO(commonAckReceived),                // ACK_RECEIVED
+         ST_NONE,                                 // ACK_TIMEOUT
+         ST_DO(commonKbPress),                    // KB_PRESS
+         ST_DO(commonKbEvent),                    // KB_EVENT
+         ST_IF(readyLoopWait, RUN_STATE),         // IDLE_LOOP_WAIT
+         ST_DO(commonAckTimeout),                 // ACK_WAIT_TIMER
+         ST_DO(commonKeepAlive),                  // KEEPALIVE_SEND_TIMER
+         ST_GO(IDLE_STATE),                       // IDLE_TIMER
+         ST_NONE,                                 // KB_DEBOUNCE_TIMER
+         ST_NONE,                                 // KB_POLL_TIMER
+         ST_DO(readyFlash),                       // READY_FLASH_TIMER
+         ST_NONE),                                // GESTURE_DEBOUNCE_TIMER
+  // RUN_STATE
+  ST_ROW(ST_NONE,                                 // NIL_EVENT
+         ST_NONE,                                 // SYSTEM_INIT
+         ST_NONE,                                 // MVMT_SAMPLE_READY
+         ST_NONE,                                 // TIMER_EXPIRED
+         ST_NONE,                                 // MVMT_OCCURED
+         ST_DO(commonAckReceived),                // ACK_RECEIVED
+         ST_NONE,                                 // ACK_TIMEOUT
+         ST_DO(commonKbPress),                    // KB_PRESS
+         ST_DO(commonKbEvent),                    // KB_EVENT
+         ST_IF(runLoopWait, READY_STATE),         // IDLE_LOOP_WAIT
+         ST_DO(commonAckTimeout),                 // ACK_WAIT_TIMER
+         ST_DO(commonKeepAlive),                  // KEEPALIVE_SEND_TIMER
+         ST_NONE,                                 // IDLE_TIMER
+         ST_NONE,                                 // KB_DEBOUNCE_TIMER
+         ST_NONE,                                 // KB_POLL_TIMER
+         ST_NONE,                                 // READY_FLASH_TIMER
+         ST_DO(runGestureDebounce))               // GESTURE_DEBOUNCE_TIMER
+};
+
+// The build fails here if the table is out of step with the 
+// states, events or timers
+typedef char stTableRowsCheck[(sizeof(stTable)/sizeof(stTable[0]) == MAX_STATES) ? 1 : -1];
+typedef char stTableColumnsCheck[(ST_ROW_LENGTH == ST_NUM_TRIGGERS) ? 1 : -1];
+
+static const t_StEntryExit stEntry[MAX_STATES] = 
+{ &idleStateEnter,
+  &readyStateEnter,
+  &runStateEnter};
+
+static const t_StEntryExit stExit[MAX_STATES] = 
+{ NULL,
+  &readyStateExit,
+  &runStateExit};
+
+// ******************************************
+// END STATE TABLE
+// ******************************************
+
+// Prototypes for doing work in this module  
+BOOL                lowPowerHandler(t_AppStates state);
+static void         netCallback(t_NetPacket *data);
+extern volatile     t_CADB GlobalData;
+void processKBEvent (t_Event *pEvent, int *handled);
+static BOOL runSendNeeded(INT16 angle);
+
+// RTI settings the main loop sleeps with, longest first, and how long
+// each really is in MC13192 ticks.  The 62.5kHz doze clock is divided
+// by 256 to 32768, which is 4 MC13192 ticks per doze clock tick.  The
+// fine ones run the doze clock at 1MHz for the last bit before a 
+// deadline (HAL_MCU_sleepFine).
+typedef struct {
+  UINT8  rti;         // HAL_MCU_sleep value
+  BOOL   fine;        // TRUE for HAL_MCU_sleepFine
+  t_time ticks;       // sleep length
+} t_SleepStep;
+
+static const t_SleepStep sleepSteps[] = {
+  {RTI_EXT_DOZE_512_MSEC,   FALSE, 131072},
+  {RTI_EXT_DOZE_256_MSEC,   FALSE, 65536},
+  {RTI_EXT_DOZE_128_MSEC,   FALSE, 32768},
+  {RTI_EXT_DOZE_64_MSEC,    FALSE, 16384},
+  {RTI_EXT_DOZE_32_MSEC,    FALSE, 8192},
+  {RTI_EXT_DOZE_16_MSEC,    FALSE, 4096},
+  {RTI_EXT_DOZE_4_MSEC,     FALSE, 1024},
+  {RTI_FINE_DOZE_2_MSEC,    TRUE,  512},
+  {RTI_FINE_DOZE_1_MSEC,    TRUE,  256},
+  {RTI_FINE_DOZE_256_uSEC,  TRUE,  64}
+};
+#define NUM_SLEEP_STEPS   (sizeof(sleepSteps)/sizeof(sleepSteps[0]))
+
+// Time to get into and out of STOP3 (clock switch, SPI write, port
+// setup), a sleep only fits if this is left over as well.  A sleep 
+// that ends a quarter short or more was cut off by an interrupt.
+#define SLEEP_OVERHEAD_TICKS  12
+#define SLEEP_EARLY_SHIFT     2
+
+// Sleep statistics for each state, for looking at in the debugger
+static t_SleepStats sleepStats[MAX_STATES];
+
+// Globals needed for run state.  Accelerometer samples are run
+// through the filter to remove noise, see filter.h for settings.
+static t_Filter runFilter;
+static tAccSample runFiltered[ACC_NUM_AXES];
+static BOOL gestureOffDetect;
+
+// Transmit suppression state for run state
+static INT16 runSentAngle;   // angle in last packet sent
+static UINT8 runTxSkipped;   // filtered samples not sent since then
+static UINT8 runTxStartup;   // packets left to send unconditionally
+
+// S1 asks for a new channel survey.  It runs from the ready state
+// where the 13192 is awake, entering ready surveys anyway.
+static BOOL surveyRequested=FALSE;
+static void surveyQuietChannel(void);
+
+/****************************************************************************
+ * stMachDispatch
+ *
+ * Description: Runs an event through the state table.  The event id is
+ *              set to NIL_EVENT first, an action that has a new event
+ *              to process puts it there.
+ *
+ * Parms:       state  - current state
+ *              pEvent - pointer to currently processing event.
+ *
+ * Returns:     next state, or state if no change
+ ***************************************************************************/
+t_AppStates stMachDispatch(t_AppStates state, t_Event *pEvent)
+{
+  const t_StTransition *trans;
+  UINT8 trigger;
+  BOOL  go=TRUE;
+
+  if (pEvent->eventId != TIMER_EXPIRED) {
+    trigger = (UINT8)pEvent->eventId;
+  } else if (pEvent->timerId >= 0 && pEvent->timerId < MAX_TIMERS) {
+    trigger = (UINT8)ST_TIMER(pEvent->timerId);
+  } else {
+    trigger = ST_NUM_TRIGGERS;
+  }
+  pEvent->eventId = NIL_EVENT;
+
+  // sanity check
+  if (state >= MAX_STATES || trigger >= ST_NUM_TRIGGERS) {
+    return state;
+  }
+
+  trans = &stTable[state][trigger];
+  if (trans->action != NULL) {
+    go = trans->action(pEvent);
+  }
+
+  if (trans->next == ST_STAY || !go) {
+    return state;
+  }
+
+  if (stExit[state] != NULL) {
+    stExit[state](pEvent);
+  }
+#ifdef HOST_SIM
+  simStateChange(state, (t_AppStates)trans->next, trigger);
+#endif
+  state = (t_AppStates)trans->next;
+  stEntry[state](pEvent);
+
+  return state;
+}
+
+/****************************************************************************
+ * commonAckReceived
+ *
+ * Description: The receiver acked, all states.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL commonAckReceived(t_Event *pEvent)
+{
+  // Clear any alarms, we got an ack!
+  alarmRFProblem(FALSE);
+
+  // Stop the timer
+  stopTimer(ACK_WAIT_TIMER);
+
+  // Trim transmit power from the receiver's link report
+  adjustRFPower(TRUE);
+  return TRUE;
+}
+
+/****************************************************************************
+ * commonKbPress
+ *
+ * Description: A key was pressed, all states.  When the keyboard 
+ *              debounce timer pops then we'll process the keyboard 
+ *              press.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL commonKbPress(t_Event *pEvent)
+{
+  // Start the debounce timer
+  startTimer(KB_DEBOUNCE_TIMER, FALSE);
+  return TRUE;
+}
+
+/****************************************************************************
+ * commonKbEvent
+ *
+ * Description: Keyboard debounce finished, all states.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE if a key was handled
+ ***************************************************************************/
+static BOOL commonKbEvent(t_Event *pEvent)
+{
+  int handled=0;
+
+  processKBEvent(pEvent, &handled);
+  return (handled != 0);
+}
+
+/****************************************************************************
+ * commonAckTimeout
+ *
+ * Description: ACK_WAIT_TIMER expired, the receiver didn't answer the
+ *              keepalive.  All states.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL commonAckTimeout(t_Event *pEvent)
+{
+  // Generate RF alarm
+  alarmRFProblem(TRUE);
+
+  // More power, fast
+  adjustRFPower(FALSE);
+  return TRUE;
+}
+
+/****************************************************************************
+ * commonKeepAlive
+ *
+ * Description: KEEPALIVE_SEND_TIMER expired, time to send another 
+ *              packet to the receiver.  All states.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL commonKeepAlive(t_Event *pEvent)
+{
+  // Always send a packet to the receiver regardless
+  // of the alarm status. This allows the detector and
+  // receiver to generate LED status if they are not
+  // in range of each other - or if channel is not
+  // configured properly.
+
+  // clear ack received flag
+  pEvent->pCADB->ackReceived = FALSE;
+
+  if (!sendRFMessage(KEEPALIVE)) {
+    alarmRFProblem(TRUE);
+  } else {
+    // Turn on receiver and set ack timer
+    rcvRFData(netCallback);
+    startTimer(ACK_WAIT_TIMER, FALSE);
+  }
+  return TRUE;
+}
+
+/****************************************************************************
+ * idleStateEnter
+ *
+ * Description: Setup for the idle state.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void idleStateEnter(t_Event *pEvent)
+{
+  // Initialize the movement system, not sampling too fast in this state
+  // because it is not required, and we want to sleep as much as possible.
+  movementInit(ACC_SAMPLES_PER_SECOND_SLOW);
+
+  // No LEDs in idle state  
+  runLed(FALSE);
+  alarmRFProblem(FALSE);
+
+  // Put RF Device into low power mode until we need it
+  HAL_RF_lowpower();
+
+  // Sample approximately 16 times per second in this state.  The 
+  // ready state's timers were stopped on the way out, the keyboard
+  // timers carry on.
+  setSampleClock(ACC_SAMPLE_FREQUENCY_SLOW);
+
+  // Start polling the keyboard
+  startTimer(KB_POLL_TIMER, TRUE);
+}
+
+/****************************************************************************
+ * idleLoopWait
+ *
+ * Description: Idle state IDLE_LOOP_WAIT.  Sleeps, then takes a 
+ *              movement sample.
+ *
+ * Parms:       pEvent - pointer to currently processing event, set to
+ *                       MVMT_SAMPLE_READY when a sample is ready
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL idleLoopWait(t_Event *pEvent)
+{
+  // **********************************************************
+  // MCU STOP MODE!!!!
+  // **********************************************************
+
+  // Let the MCU sleep to conserve battery life until the next
+  // sample or timer is due, whichever is first.
+  if (!lowPowerHandler(IDLE_STATE)) {
+    // only a timer, handled next
+    return TRUE;
+  }
+
+  // **********************************************************
+  // MCU back from STOP mode.  
+  // **********************************************************
+
+  // Each sample time take an accelerometer 
+  // movement reading.  A movement sample requires quite
+  // a bit of processing because of the math involved.
+  if (movementSample()) {
+    // Next time through the loop, process this event
+    pEvent->eventId = MVMT_SAMPLE_READY;
+  }
+  return TRUE;
+}
+
+/****************************************************************************
+ * idleMovement
+ *
+ * Description: Idle state MVMT_SAMPLE_READY.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE to go to the ready state
+ ***************************************************************************/
+static BOOL idleMovement(t_Event *pEvent)
+{
+  BOOL moved;
+
+  // if movement detected transition to ready mode
+  moved = movementDetected();
+
+  // reinitialize the movement system for next sample period, ready
+  // state entry sets it up again for its own rate
+  movementInit(ACC_SAMPLES_PER_SECOND_SLOW);
+  return moved;
+}
+
+/****************************************************************************
+ * readyStateEnter
+ *
+ * Description: Ready state entry.  In this state the RF is powered up
+ *              in IDLE mode, but MCU is still sleeping periodically.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void readyStateEnter(t_Event *pEvent)
+{
+  // Initialize the movement system, crank it up to fast mode
+  movementInit(ACC_SAMPLES_PER_SECOND_FAST);
+
+  // Start looking for on gesture
+  gestureInit();
+
+  // Flash LED in ready mode
+  runLed(FALSE);
+  readyLedFlash();
+
+  // Sample approximately 256 times per second in this state  
+  setSampleClock(ACC_SAMPLE_FREQUENCY_FAST);
+
+  // Start timer to keep monitoring movement.  We'll transition
+  // back to idle if no movement detected  
+  startTimer(IDLE_TIMER, FALSE);
+  startTimer(KEEPALIVE_SEND_TIMER, TRUE);
+  startTimer(READY_FLASH_TIMER, FALSE);
+  startTimer(KB_POLL_TIMER, TRUE);
+
+  // wake up the RF device, which will take ~ 323uSeconds for 13192. 
+  // we do this because we want instant response once the gesture
+  // to turn on wah pedal is recognized
+  HAL_RF_wake_wait();
+
+  // Find the quietest channel before the pedal is used, the 
+  // receiver follows us there
+  surveyQuietChannel();
+
+  // Make sure receiver knows the pedal is off
+  sendRFMessage(WAH_OFF);
+}
+
+/****************************************************************************
+ * readyStateExit
+ *
+ * Description: Ready state exit.  The keepalive and ready state timers
+ *              aren't used in the idle or run states.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void readyStateExit(t_Event *pEvent)
+{
+  stopTimer(ACK_WAIT_TIMER);
+  stopTimer(KEEPALIVE_SEND_TIMER);
+  stopTimer(IDLE_TIMER);
+  stopTimer(READY_FLASH_TIMER);
+}
+
+/****************************************************************************
+ * readyLoopWait
+ *
+ * Description: Ready state IDLE_LOOP_WAIT.  Sleeps, then samples 
+ *              looking for movement and the on gesture.
+ *
+ * Parms:       pEvent - pointer to currently processing event, set to
+ *                       MVMT_SAMPLE_READY when a sample is ready
+ *
+ * Returns:     TRUE to go to the run state
+ ***************************************************************************/
+static BOOL readyLoopWait(t_Event *pEvent)
+{
+  if (surveyRequested) {
+    surveyQuietChannel();
+  }
+
+  // Sampling at 256 times per second along with all of
+  // the math involved leaves little time, but sleep for
+  // whatever is left until the next sample or timer.
+  if (!lowPowerHandler(READY_STATE)) {
+    return FALSE;
+  }
+
+  // In this mode, we are monitoring for WAH-ON gesture.
+  // If we get it, we enter RUN mode.  The WAH-ON gesture
+  // requires movement samples which are math intensive. 
+  // However, we are not monitoring for general movement
+  // so we don't need an entire sample window, just look
+  // at one sample to the next.      
+  //
+  // However, we also need to monitor for general movement
+  // because we need to turn off automatically if no movement
+  // occurs within window.
+  if (movementSample()) {
+    // Next time through the loop, process this event
+    pEvent->eventId = MVMT_SAMPLE_READY;
+  }
+
+  // Determine if gesture ON has occured
+  return gestureOnDetected();
+}
+
+/****************************************************************************
+ * readyMovement
+ *
+ * Description: Ready state MVMT_SAMPLE_READY.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL readyMovement(t_Event *pEvent)
+{
+  // if movement detected remain in this mode
+  if (movementDetected()) {
+    // restart idle timer
+    stopTimer(IDLE_TIMER);
+    startTimer(IDLE_TIMER, FALSE);
+  }
+
+  // reinitialize the movement system
+  movementInit(ACC_SAMPLES_PER_SECOND_FAST);
+  return TRUE;
+}
+
+/****************************************************************************
+ * readyFlash
+ *
+ * Description: Ready state READY_FLASH_TIMER, flashes the LED.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL readyFlash(t_Event *pEvent)
+{
+  readyLedFlash();
+  startTimer(READY_FLASH_TIMER, FALSE);
+  return TRUE;
+}
+
+/****************************************************************************
+ * runStateEnter
+ *
+ * Description: run state entry
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void runStateEnter(t_Event *pEvent)
+{
+  // Sample at the filter's rate in this state, the ready state
+  // stopped its timers on the way out
+  setSampleClock(FILTER_SAMPLE_MS);
+
+  // Wait before checking for off gesture 
+  startTimer(GESTURE_DEBOUNCE_TIMER, FALSE);
+
+  // LED to notify user that run mode is entered
+  runLed(TRUE);
+
+  gestureOffDetect = FALSE;
+  gestureInit();
+
+  // Make sure receiver is off (from ack receive), we're going to start
+  // transmitting at this point
+  stopReceive();
+
+  // Make sure receiver knows the pedal is off
+  sendRFMessage(WAH_ON);
+  filterInit(&runFilter);
+  runSentAngle = FIXED_ATAN2_INVALID;
+  runTxSkipped = 0;
+  runTxStartup = RUN_TX_STARTUP_PACKETS;
+
+  pEvent->eventId = NIL_EVENT;
+}
+
+/****************************************************************************
+ * runStateExit
+ *
+ * Description: run state exit
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void runStateExit(t_Event *pEvent)
+{
+  stopTimer(GESTURE_DEBOUNCE_TIMER);
+}
+
+/****************************************************************************
+ * runLoopWait
+ *
+ * Description: Run state IDLE_LOOP_WAIT.  Sleeps, then samples, 
+ *              filters and sends the pedal position.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE to go back to the ready state
+ ***************************************************************************/
+static BOOL runLoopWait(t_Event *pEvent)
+{
+  static tAccSample sample[ACC_NUM_AXES];
+  static INT16 angle;
+
+  // Sample 250 times/second...
+  // sleep MCU until the next 4 ms sample, then sample
+  if (!lowPowerHandler(RUN_STATE)) {
+    return FALSE;
+  }
+
+  // sample all axes
+  ACC_read(&sample[ACC_AXIS_X], &sample[ACC_AXIS_Y], &sample[ACC_AXIS_Z]);
+
+  // remove noise from the sampled data (software filtering)
+  if (!filterSample(&runFilter, sample, runFiltered)) {
+    return FALSE;
+  }
+
+  // Send the pedal angle (or the filtered accelerometer 
+  // samples) to receiver, but only if the pedal moved or it's
+  // time for a heartbeat.  The send returns while the radio
+  // is still transmitting so the 4ms sample rate holds.
+  angle = fixedAtan2(runFiltered[ACC_AXIS_Y], runFiltered[ACC_AXIS_Z]);
+  if (!runSendNeeded(angle)) {
+    runTxSkipped++;
+  } else if (isRFSendBusy()) {
+    // last frame still in the air, not a radio problem.  Skip
+    // this sample and leave runSentAngle so the next one retries.
+  } else {
+#ifdef NET_ANGLE_PACKETS
+    if (!sendRFAngle(angle)) {
+#else
+    if (!sendRFMovement(runFiltered[ACC_AXIS_X], runFiltered[ACC_AXIS_Y], 
+                        runFiltered[ACC_AXIS_Z])) {
+#endif
+      // leave runSentAngle alone so the next sample retries
+      alarmRFProblem(TRUE);
+    } else {
+      alarmRFProblem(FALSE);
+      runSentAngle = angle;
+      runTxSkipped = 0;
+    }
+  }
+
+  // Use filtered X sample to detect off gesture, once it's ok
+  // to look for it
+  return (gestureOffDetect && 
+          gestureOffDetected(runFiltered[ACC_AXIS_X], GESTURE_OFF_ACCELERATION));
+}
+
+/****************************************************************************
+ * runGestureDebounce
+ *
+ * Description: Run state GESTURE_DEBOUNCE_TIMER.  Start checking for 
+ *              gesture off now, if detected it will take us out of 
+ *              this state.
+ *
+ * Parms:       pEvent - pointer to currently processing event.
+ *
+ * Returns:     TRUE
+ ***************************************************************************/
+static BOOL runGestureDebounce(t_Event *pEvent)
+{
+  gestureOffDetect = TRUE;
+  return TRUE;
+}
+
+/****************************************************************************
+ * runSendNeeded
+ *
+ * Description: Transmit policy for run state movement packets.  Decides
+ *              if the latest filtered sample is worth the airtime.
+ *
+ * Parms:       angle - pedal angle of the sample, tenths of a degree
+ *
+ * Returns:     TRUE if the packet should be sent
+ ***************************************************************************/
+static BOOL runSendNeeded(INT16 angle)
+{
+  INT16 delta;
+
+  if (runTxStartup > 0) {
+    runTxStartup--;
+    return TRUE;
+  }
+
+  // heartbeat
+  if (runTxSkipped >= RUN_TX_HEARTBEAT_COUNT) {
+    return TRUE;
+  }
+
+  if (angle == FIXED_ATAN2_INVALID || runSentAngle == FIXED_ATAN2_INVALID) {
+    return (angle != runSentAngle);
+  }
+
+  // Readings are unsigned so the angle never wraps around
+  delta = angle - runSentAngle;
+  if (delta < 0) {
+    delta = -delta;
+  }
+
+  return (delta > RUN_TX_HYSTERESIS);
+}
+
+/****************************************************************************
+ * processKBEvent
+ *
+ * Description: handles kb press
+ *
+ * Parms:       pEvent - pointer to currently processing event, handled.
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void processKBEvent(t_Event *pEvent, int *handled)
+{
+  if (pEvent->pCADB->s1Pressed) {
+    // survey for a quieter RF channel once the radio is up
+    surveyRequested = TRUE;
+    *handled=1;
+
+    // don't come back here again until user presses again
+    pEvent->pCADB->s1Pressed = FALSE;
+  }
+}
+
+/****************************************************************************
+ * surveyQuietChannel
+ *
+ * Description: Moves the transmitter and receiver to the quietest 
+ *              channel.  The survey gets its own acks, so the keepalive
+ *              alarm is updated here.  The 13192 must be awake.
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void surveyQuietChannel(void)
+{
+  surveyRequested = FALSE;
+
+  if (selectQuietRFChannel()) {
+    alarmRFProblem(FALSE);
+    stopTimer(ACK_WAIT_TIMER);
+  } else {
+    alarmRFProblem(TRUE);
+  }
+}
+
+/****************************************************************************
+ * netCallback
+ *
+ * Description: callback procedure that gets invoked when a packet arrives
+ *
+ * Parms:       *data - pointer to received packet
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void netCallback(t_NetPacket *data)
+{
+  // We got an acknowledgement from receiver, let the state
+  // machine know.  If the queue is full set the global flag,
+  // the ack wait timer picks it up.
+  if (data->msgType == WAH_ACK) {
+    if (!postEvent(ACK_RECEIVED, 0)) {
+      GlobalData.ackReceived = TRUE;
+    }
+  }
+}
+
+
+/****************************************************************************
+ * lowPowerHandler
+ *
+ * Description: The low power handler for the state machine.  Puts the 
+ *              MCU into STOP3 mode until the next deadline, the sample
+ *              clock or a timer.  The RTI only has a few lengths, so 
+ *              this sleeps the longest one that fits, again and again,
+ *              finishing with short sleeps on the fast doze clock.  
+ *              Only the last 300us or so is waited out awake.  An 
+ *              interrupt that ends a sleep early just means one more
+ *              sleep, unless it queued an event, which is handled 
+ *              straight away.  The ATD doesn't run in STOP3, so when a sample
+ *              is what we're waiting for the scan is started as the
+ *              last sleep ends and converts while we wait out the rest.
+ *
+ * Parms:       state - state sleeping, for the statistics
+ *
+ * Returns:     TRUE if it's time to sample, FALSE if only a timer or
+ *              a queued event is due
+ ***************************************************************************/
+BOOL lowPowerHandler(t_AppStates state)
+{
+  static t_time now, deadline, remaining, start, slept;
+  t_SleepStats *stats = &sleepStats[state];
+  UINT8 step;
+  BOOL sampling;
+
+  if (eventsPending()) {
+    // something is waiting to be handled, don't sleep
+    return sampleClockDue();
+  }
+
+  sampling = getNextDeadline(&deadline);
+
+  for (;;) {
+    HAL_getTicks(&now);
+    remaining = (deadline - now) & MAX_TIME_VALUE;
+    if (remaining == 0 || remaining >= TIMER_HALF_RANGE) {
+      // deadline has passed
+      break;
+    }
+
+    for (step=0; step<NUM_SLEEP_STEPS && 
+         sleepSteps[step].ticks + SLEEP_OVERHEAD_TICKS > remaining; step++) {
+    }
+
+    if (step == NUM_SLEEP_STEPS) {
+      // too short to sleep.  The scan is done well before the
+      // deadline so ACC_read normally finds it waiting.
+      if (sampling) {
+        ACC_startScan();
+      }
+      start = now;
+      do {
+        HAL_getTicks(&now);
+        remaining = (deadline - now) & MAX_TIME_VALUE;
+      } while (remaining != 0 && remaining < TIMER_HALF_RANGE);
+      stats->spinTicks += (now - start) & MAX_TIME_VALUE;
+      break;
+    }
+
+    // put MCU into stop mode 
+    start = now;
+    if (sleepSteps[step].fine) {
+      HAL_MCU_sleepFine(sleepSteps[step].rti);
+    } else {
+      HAL_MCU_sleep(sleepSteps[step].rti, FALSE);
+    }
+    HAL_getTicks(&now);
+    slept = (now - start) & MAX_TIME_VALUE;
+
+    if (sleepSteps[step].fine) {
+      stats->fineSleeps++;
+      stats->fineTicks += slept;
+    } else {
+      stats->sleeps++;
+    }
+    if (slept < sleepSteps[step].ticks - (sleepSteps[step].ticks >> SLEEP_EARLY_SHIFT)) {
+      stats->earlyWakes++;
+    }
+
+    if (eventsPending()) {
+      // woken by a key or a packet, don't go back to sleep on it
+      break;
+    }
+  }
+
+  return sampleClockDue();
+}
+
+/****************************************************************************
+ * getSleepStats
+ *
+ * Description: Sleep statistics of a state
+ *
+ * Parms:       state - state
+ *              stats - filled in
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void getSleepStats(t_AppStates state, t_SleepStats *stats)
+{
+  *stats = sleepStats[state];
+}
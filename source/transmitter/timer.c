@@ -1,261 +1,396 @@
-/****************************************************************************
-* timer.c
-* 
-* Author: 	Bill Bishop - Sixth Sensor
-* Title: 	timer.c
-* 
-* Simple timer system provides for inaccurate but simple timing functions.
-* The handleLoopTimer is to be called from within a loop at regular 
-* intervals.  The interval is specified in the setTimerBase() function.
-* The application can change the loop timing at run time, but it must
-* call setTimerBase() and must restart any active timers.
-*
-* When a timeout occurs the timeout function will be called.  The application
-* is responsible for all timeout handling. 
-*
-****************************************************************************/
-#include "timer.h"
-#include <stdtypes.h>
-
-// Timer handler prototypes
-extern int ackWaitTimer(t_Event *);
-extern int keepAliveTimer(t_Event *);
-extern int idleTimer(t_Event *);
-extern int kbDebounceTimer(t_Event *);
-extern int kbPollTimer(t_Event *);
-extern int readyFlashTimer(t_Event *);
-extern int gestureDebounceTimer(t_Event *);
-
-// For fast timer stops, no sanity checks
-static void stopTimerFast(t_TimerId timerId);
-
-// For optimization, not a counter - just a flag
-static int timersRunning=0;
-
-// The order here decides priority.  Care must be taken when defining
-// timeout values.  If two timers expire at the same time then only
-// one is handled.  The next call to handleLoopTimer() will then
-// handle the second timer.  So care must be taken so that a quick
-// timer doesn't hog up all the ticks!
-t_TmrHandlers tmrHandlers[] = 
-{ACK_WAIT_TIMEOUT_MSEC,       0, NIL_TIME, FALSE, &ackWaitTimer,
-  KEEPALIVE_SEND_TIMEOUT_MSEC, 0, NIL_TIME, FALSE, &keepAliveTimer,
-  IDLE_TIMEOUT_MSEC,           0, NIL_TIME, FALSE, &idleTimer,
-  KB_DEBOUNCE_TIMEOUT_MSEC,    0, NIL_TIME, FALSE, &kbDebounceTimer,
-  KB_POLL_TIMEOUT_MSEC,        0, NIL_TIME, FALSE, &kbPollTimer,
-  READY_FLASH_TIMEOUT_MSEC,    0, NIL_TIME, FALSE, &readyFlashTimer,
-  GESTURE_DEBOUNCE_TIMEOUT_MSEC,0, NIL_TIME, FALSE, &gestureDebounceTimer,
-  0, 0, NIL_TIME, FALSE, 0
-};
-
-/****************************************************************************
- * setTimerBase
- *
- * Description: Sets the number of times per second that the timer loop
- *              will be invoked.  NOTE: all timers will be stopped. You 
- *              must restart timers when you change the timer base.
- *
- * Parms:       ticksPerSecond - number of times the loop timer will be
- *              called per second.
- *
- * Returns:     nothing 
- ***************************************************************************/
-void setTimerBase(int ticksPerSecond)
-{
-  int cnt = 0;
-
-  if (ticksPerSecond > 0) {
-    // first stop all timers!  
-    stopAllTimers();
-
-    // set the timeoutCount (number of ticks before timeout)
-    // for each timer
-    for (cnt=0; cnt<MAX_TIMERS; cnt++) {
-      tmrHandlers[cnt].timeoutCount = tmrHandlers[cnt].timeoutMs / ticksPerSecond;
-    }
-  }
-}
-
-/****************************************************************************
- * stopAllTimers
- *
- * Description: Stops all active timers
- *
- * Parms:       none
- *
- * Returns:     nothing 
- ***************************************************************************/
-void stopAllTimers(void)
-{
-  int cnt;
-
-  timersRunning=0;
-  for (cnt=0; cnt<MAX_TIMERS; cnt++) {
-    stopTimerFast(cnt);
-  }
-}
-
-/****************************************************************************
- * startTimer
- *
- * Description: Starts a given timer
- *
- * Parms:       timerId - which timer to start
- *              restartOnTimeout - whether or not to automatically restart 
- *
- * Returns:     nothing 
- ***************************************************************************/
-void startTimer(t_TimerId timerId, BOOL restartOnTimeout)
-{
-  timersRunning=1;
-
-  // sanity check
-  if (timerId > MAX_TIMERS || timerId < 0) {
-    return;
-  }
-
-  // easy, just start the tick count.  It's up to the application
-  // to call handleLoopTimer().  
-  tmrHandlers[timerId].tickCount = 0;
-  tmrHandlers[timerId].restart = restartOnTimeout;
-}
-
-/****************************************************************************
- * stopTimer
- *
- * Description: stop a given timer
- *
- * Parms:       timerId - which timer to stop
- *
- * Returns:     nothing 
- ***************************************************************************/
-void stopTimer(t_TimerId timerId)
-{
-  // sanity check
-  if (timerId > MAX_TIMERS || timerId < 0) {
-    return;
-  }
-
-  // easy, just start the tick count.  It's up to the application
-  // to call handleLoopTimer().  
-  tmrHandlers[timerId].tickCount = NIL_TIME;
-}
-
-/****************************************************************************
- * stopTimerFast
- *
- * Description: stop a given timer (Fast Version)
- *
- * Parms:       timerId - which timer to stop
- *
- * Returns:     nothing 
- ***************************************************************************/
-static void stopTimerFast(t_TimerId timerId)
-{
-  // easy, just start the tick count.  It's up to the application
-  // to call handleLoopTimer().  
-  tmrHandlers[timerId].tickCount = NIL_TIME;
-}
-
-/****************************************************************************
- * tmrStarted
- *
- * Description: determines if timer has been started
- *
- * Parms:       timerId - which timer to check
- *
- * Returns:     True if tmr started, false if not 
- ***************************************************************************/
-static int tmrStarted(int tmrIdx)
-{
-  return(tmrHandlers[tmrIdx].tickCount != NIL_TIME);
-}
-
-/****************************************************************************
- * tmrExpired
- *
- * Description: determines if timer is expired
- *
- * Parms:       timerId - which timer to check
- *
- * Returns:     True if tmr expired, false if not 
- ***************************************************************************/
-static int tmrExpired(int tmrIdx)
-{
-  //int loopTimer = LOOP_TIMER;
-  int expired = 0;
-
-  // If timer is just now expiring or has expired in the past
-  expired = (tmrHandlers[tmrIdx].tickCount >= tmrHandlers[tmrIdx].timeoutCount);
-
-  // only restart timer if restart==true  
-  if (expired) {
-    if (tmrHandlers[tmrIdx].restart)
-      tmrHandlers[tmrIdx].tickCount = 0;
-    else
-      tmrHandlers[tmrIdx].tickCount = NIL_TIME;
-  }
-  return(expired);
-}
-
-/****************************************************************************
- * incrTimers
- *
- * Description: Increments all started timers
- *
- * Parms:       none
- *
- * Returns:     nothing
- ***************************************************************************/
-static void incrTimers()
-{
-  int cnt;
-
-  for (cnt=0; cnt<MAX_TIMERS; cnt++) {
-    if (tmrStarted(cnt)) {
-      tmrHandlers[cnt].tickCount++;
-    }
-  }
-}
-
-/****************************************************************************
- * incrTimers
- *
- * Description: Calls appropriate timer handler based on counter.
- *              Counter is assumed to be in increments of LOOP_TIMER.
- *              Updates event only if process is TRUE
- *              otherwise just keeps up with timers
- *              automatically stops timer when expired
- *
- * Parms:       event   - pointer to system event.  Will be updated if expiry
- *              process - if true, then tmr expiry is checked.  If false
- *                        then just the tick is recorded - no timeouts occur.
- *
- * Returns:     nothing
- ***************************************************************************/
-void handleLoopTimer(t_Event *event, BOOL process)
-{
-  int cnt=0;
-  //int index;
-
-  // for speed, don't process if no timers running
-  if (timersRunning) {
-    // keep up with ticks each time through
-    incrTimers();
-
-    // Increment each started timer and call tmr handlers if timeout occured
-    for (cnt=0; cnt<MAX_TIMERS && process; cnt++) {
-      if (tmrStarted(cnt)) {
-        // has timer expired
-        if (tmrExpired(cnt)) {
-          // time to kick this timer handler!
-          tmrHandlers[cnt].timerHdlrFunc(event);
-
-          // only one timeout supported at a time
-          break;
-        }// timer expired
-      }// timer started
-    }// for
-  }// if running timers
-}
-
+/****************************************************************************
+* timer.c
+* 
+* Author: 	Bill Bishop - Sixth Sensor
+* Title: 	timer.c
+* 
+* Simple timer system.  Each running timer has an absolute deadline on the
+* MC13192 clock, so the main loop doesn't have to run at a fixed rate and
+* nothing needs rescaling when it changes.  The handleLoopTimer is called
+* each time through the main loop, getNextDeadline() tells the loop how 
+* long it may sleep.
+*
+* When a timeout occurs the timeout function will be called.  The application
+* is responsible for all timeout handling. 
+*
+* Running timers are kept in a list sorted by deadline, so finding the next
+* deadline or an expired timer only looks at the head of the list.  Every
+* timer that has expired is posted to the event queue by handleLoopTimer()
+* in tmrHandlers order, so two timers expiring together are never lost.
+*
+* The sample clock is a periodic deadline of its own for the state's 
+* accelerometer sampling.
+*
+****************************************************************************/
+#include "timer.h"
+#include <stdtypes.h>
+
+// Timer handler prototypes
+extern int ackWaitTimer(t_Event *);
+extern int keepAliveTimer(t_Event *);
+extern int idleTimer(t_Event *);
+extern int kbDebounceTimer(t_Event *);
+extern int kbPollTimer(t_Event *);
+extern int readyFlashTimer(t_Event *);
+extern int gestureDebounceTimer(t_Event *);
+
+// End of the deadline list
+#define TIMER_LIST_END  MAX_TIMERS
+
+// TRUE if 24 bit time a is before b, works across the wrap as long
+// as they are less than TIMER_HALF_RANGE apart
+#define timeBefore(a, b)  ((((a) - (b)) & MAX_TIME_VALUE) >= TIMER_HALF_RANGE)
+
+// For fast timer stops, no sanity checks
+static void stopTimerFast(t_TimerId timerId);
+static void listInsert(UINT8 tmrIdx);
+static void listRemove(UINT8 tmrIdx);
+
+// First timer to expire, TIMER_LIST_END if none running
+static UINT8 timerHead=TIMER_LIST_END;
+
+// Expired timers not posted yet, one bit per timer.  The
+// lowest bit goes first, so this must have MAX_TIMERS bits.
+static UINT16 timersExpired=0;
+
+// Sample clock, off when the period is 0
+static t_time sampleDeadline;
+static t_time samplePeriod=0;
+
+// The order here decides priority.  If two timers expire at the 
+// same time the first one here is posted first.
+t_TmrHandlers tmrHandlers[] = 
+{
+  {ACK_WAIT_TIMEOUT_MSEC,       0, FALSE, FALSE, &ackWaitTimer, TIMER_LIST_END},
+  {KEEPALIVE_SEND_TIMEOUT_MSEC, 0, FALSE, FALSE, &keepAliveTimer, TIMER_LIST_END},
+  {IDLE_TIMEOUT_MSEC,           0, FALSE, FALSE, &idleTimer, TIMER_LIST_END},
+  {KB_DEBOUNCE_TIMEOUT_MSEC,    0, FALSE, FALSE, &kbDebounceTimer, TIMER_LIST_END},
+  {KB_POLL_TIMEOUT_MSEC,        0, FALSE, FALSE, &kbPollTimer, TIMER_LIST_END},
+  {READY_FLASH_TIMEOUT_MSEC,    0, FALSE, FALSE, &readyFlashTimer, TIMER_LIST_END},
+  {GESTURE_DEBOUNCE_TIMEOUT_MSEC,0, FALSE, FALSE, &gestureDebounceTimer, TIMER_LIST_END},
+  {0, 0, FALSE, FALSE, 0, TIMER_LIST_END}
+};
+
+/****************************************************************************
+ * setSampleClock
+ *
+ * Description: Starts the sample clock.  The first sample is due one 
+ *              period from now.  Timers are not touched.
+ *
+ * Parms:       sampleMs - sample period, 0 stops the sample clock
+ *
+ * Returns:     nothing 
+ ***************************************************************************/
+void setSampleClock(int sampleMs)
+{
+  static t_time now;
+
+  HAL_getTicks(&now);
+  samplePeriod = (t_time)sampleMs * TIMER_TICKS_PER_MS;
+  sampleDeadline = (now + samplePeriod) & MAX_TIME_VALUE;
+}
+
+/****************************************************************************
+ * sampleClockDue
+ *
+ * Description: Checks if it is time to sample, and if it is moves the 
+ *              sample clock on a period.  The clock stays on its own 
+ *              beat, but if sampling fell more than a period behind it
+ *              starts over from now rather than sampling in a burst.
+ *
+ * Parms:       none
+ *
+ * Returns:     TRUE if a sample is due
+ ***************************************************************************/
+BOOL sampleClockDue(void)
+{
+  static t_time now;
+
+  if (samplePeriod == 0) {
+    return FALSE;
+  }
+
+  HAL_getTicks(&now);
+  if (timeBefore(now, sampleDeadline)) {
+    return FALSE;
+  }
+
+  sampleDeadline = (sampleDeadline + samplePeriod) & MAX_TIME_VALUE;
+  if (!timeBefore(now, sampleDeadline)) {
+    sampleDeadline = (now + samplePeriod) & MAX_TIME_VALUE;
+  }
+  return TRUE;
+}
+
+/****************************************************************************
+ * getNextDeadline
+ *
+ * Description: The next time the main loop has something to do, the
+ *              earlier of the sample clock and the first timer.  With 
+ *              neither running it is as far off as the clock allows.
+ *
+ * Parms:       deadline - filled in, MC13192 time
+ *
+ * Returns:     TRUE if the deadline is the sample clock
+ ***************************************************************************/
+BOOL getNextDeadline(t_time *deadline)
+{
+  static t_time now;
+
+  if (timersExpired) {
+    // still some to hand out, don't sleep
+    HAL_getTicks(deadline);
+    return FALSE;
+  }
+
+  if (samplePeriod != 0) {
+    *deadline = sampleDeadline;
+    if (timerHead != TIMER_LIST_END && 
+        timeBefore(tmrHandlers[timerHead].deadline, *deadline)) {
+      *deadline = tmrHandlers[timerHead].deadline;
+      return FALSE;
+    }
+    return TRUE;
+  } 
+  
+  if (timerHead != TIMER_LIST_END) {
+    *deadline = tmrHandlers[timerHead].deadline;
+  } else {
+    HAL_getTicks(&now);
+    *deadline = (now + TIMER_HALF_RANGE - 1) & MAX_TIME_VALUE;
+  }
+  return FALSE;
+}
+
+/****************************************************************************
+ * stopAllTimers
+ *
+ * Description: Stops all active timers
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing 
+ ***************************************************************************/
+void stopAllTimers(void)
+{
+  int cnt;
+
+  for (cnt=0; cnt<MAX_TIMERS; cnt++) {
+    stopTimerFast(cnt);
+    cancelEvent(TIMER_EXPIRED, cnt);
+  }
+  timerHead = TIMER_LIST_END;
+  timersExpired = 0;
+}
+
+/****************************************************************************
+ * startTimer
+ *
+ * Description: Starts a given timer, or starts it over if running
+ *
+ * Parms:       timerId - which timer to start
+ *              restartOnTimeout - whether or not to automatically restart 
+ *
+ * Returns:     nothing 
+ ***************************************************************************/
+void startTimer(t_TimerId timerId, BOOL restartOnTimeout)
+{
+  static t_time now;
+
+  // sanity check
+  if (timerId >= MAX_TIMERS || timerId < 0) {
+    return;
+  }
+
+  if (tmrHandlers[timerId].running) {
+    listRemove(timerId);
+  }
+  timersExpired &= ~(1 << timerId);
+
+  // It's up to the application to call handleLoopTimer().  
+  HAL_getTicks(&now);
+  tmrHandlers[timerId].deadline = (now + (t_time)tmrHandlers[timerId].timeoutMs * 
+                                   TIMER_TICKS_PER_MS) & MAX_TIME_VALUE;
+  tmrHandlers[timerId].restart = restartOnTimeout;
+  listInsert(timerId);
+}
+
+/****************************************************************************
+ * stopTimer
+ *
+ * Description: stop a given timer.  If it has expired but not been 
+ *              handled yet it won't be, even if it's been posted.
+ *
+ * Parms:       timerId - which timer to stop
+ *
+ * Returns:     nothing 
+ ***************************************************************************/
+void stopTimer(t_TimerId timerId)
+{
+  // sanity check
+  if (timerId >= MAX_TIMERS || timerId < 0) {
+    return;
+  }
+
+  if (tmrHandlers[timerId].running) {
+    listRemove(timerId);
+  }
+  timersExpired &= ~(1 << timerId);
+  cancelEvent(TIMER_EXPIRED, timerId);
+}
+
+/****************************************************************************
+ * stopTimerFast
+ *
+ * Description: stop a given timer (Fast Version).  Only marks the timer
+ *              stopped, the caller looks after the list.
+ *
+ * Parms:       timerId - which timer to stop
+ *
+ * Returns:     nothing 
+ ***************************************************************************/
+static void stopTimerFast(t_TimerId timerId)
+{
+  tmrHandlers[timerId].running = FALSE;
+  tmrHandlers[timerId].next = TIMER_LIST_END;
+}
+
+/****************************************************************************
+ * listInsert
+ *
+ * Description: Puts a timer in the list by its deadline.  Timers with 
+ *              the same deadline are kept in tmrHandlers order.
+ *
+ * Parms:       tmrIdx - timer, must not be in the list
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void listInsert(UINT8 tmrIdx)
+{
+  UINT8 prev = TIMER_LIST_END;
+  UINT8 cur = timerHead;
+  t_time deadline = tmrHandlers[tmrIdx].deadline;
+
+  // Walk past everything expiring sooner, and anything expiring at
+  // the same time with higher priority
+  while (cur != TIMER_LIST_END && 
+         (timeBefore(tmrHandlers[cur].deadline, deadline) ||
+          (tmrHandlers[cur].deadline == deadline && cur < tmrIdx))) {
+    prev = cur;
+    cur = tmrHandlers[cur].next;
+  }
+
+  tmrHandlers[tmrIdx].running = TRUE;
+  tmrHandlers[tmrIdx].next = cur;
+  if (prev == TIMER_LIST_END) {
+    timerHead = tmrIdx;
+  } else {
+    tmrHandlers[prev].next = tmrIdx;
+  }
+}
+
+/****************************************************************************
+ * listRemove
+ *
+ * Description: Takes a timer out of the list.
+ *
+ * Parms:       tmrIdx - timer, must be in the list
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void listRemove(UINT8 tmrIdx)
+{
+  UINT8 prev = TIMER_LIST_END;
+  UINT8 cur = timerHead;
+
+  while (cur != tmrIdx) {
+    if (cur == TIMER_LIST_END) {
+      return;
+    }
+    prev = cur;
+    cur = tmrHandlers[cur].next;
+  }
+
+  if (prev == TIMER_LIST_END) {
+    timerHead = tmrHandlers[tmrIdx].next;
+  } else {
+    tmrHandlers[prev].next = tmrHandlers[tmrIdx].next;
+  }
+
+  stopTimerFast(tmrIdx);
+}
+
+/****************************************************************************
+ * expireTimers
+ *
+ * Description: Moves every timer whose deadline has passed to the 
+ *              expired queue.  Restarting timers go straight back in
+ *              the list a timeout after their old deadline so they 
+ *              don't drift, or a timeout from now if they fell that 
+ *              far behind.
+ *
+ * Parms:       none
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+static void expireTimers(void)
+{
+  static t_time now, timeout;
+  UINT8 tmrIdx;
+
+  if (timerHead == TIMER_LIST_END) {
+    return;
+  }
+
+  HAL_getTicks(&now);
+
+  while (timerHead != TIMER_LIST_END && 
+         !timeBefore(now, tmrHandlers[timerHead].deadline)) {
+    tmrIdx = timerHead;
+    timerHead = tmrHandlers[tmrIdx].next;
+    stopTimerFast(tmrIdx);
+
+    timersExpired |= (1 << tmrIdx);
+
+    if (tmrHandlers[tmrIdx].restart) {
+      timeout = (t_time)tmrHandlers[tmrIdx].timeoutMs * TIMER_TICKS_PER_MS;
+      tmrHandlers[tmrIdx].deadline = (tmrHandlers[tmrIdx].deadline + timeout) & MAX_TIME_VALUE;
+      if (!timeBefore(now, tmrHandlers[tmrIdx].deadline)) {
+        tmrHandlers[tmrIdx].deadline = (now + timeout) & MAX_TIME_VALUE;
+      }
+      listInsert(tmrIdx);
+    }
+  }
+}
+
+/****************************************************************************
+ * handleLoopTimer
+ *
+ * Description: Collects the timers that have expired, calls each one's
+ *              timer handler in priority order and posts the event it
+ *              sets.
+ *
+ * Parms:       event - scratch event the handlers fill in
+ *
+ * Returns:     nothing
+ ***************************************************************************/
+void handleLoopTimer(t_Event *event)
+{
+  UINT8 tmrIdx;
+
+  expireTimers();
+
+  for (tmrIdx=0; timersExpired; tmrIdx++) {
+    if (!(timersExpired & (1 << tmrIdx))) {
+      continue;
+    }
+    timersExpired &= ~(1 << tmrIdx);
+
+    // time to kick this timer handler!
+    event->eventId = NIL_EVENT;
+    tmrHandlers[tmrIdx].timerHdlrFunc(event);
+    if (event->eventId != NIL_EVENT) {
+      postEvent(event->eventId, event->timerId);
+    }
+  }
+}